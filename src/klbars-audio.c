@@ -0,0 +1,283 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KL_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define KL_HAVE_X86 0
+#endif
+
+/* Synthesis and sample conversion kernels for the tone generator.
+
+   The tone is synthesized once as floats, and these turn it into
+   samples of the output format, byte swapped when the requested byte
+   order isn't the machine's.  Integer samples are the float scaled and
+   truncated towards zero, with anything past full scale (the largest
+   float below 2^31 for 32 bits) clamped, and the SSE2 conversion
+   truncates and clamps the same way, so the C and SIMD kernels agree
+   to the bit. */
+
+#define KL_S16_CLAMP 32767.0f
+#define KL_S32_CLAMP 2147483520.0f
+
+/* Sine synthesis.
+
+   Sample i is at (phase + i * step) % modulus units of a cycle out of
+   modulus, kept as an integer so it is exact however far along the
+   tone is.  With modulus a multiple of four the phase is folded, still
+   in integers, onto the quarter cycle either side of zero, and only
+   then divided down to z in [-1/4, 1/4] cycles, for which sin(2 pi z)
+   is the odd Taylor polynomial below to well under a float's
+   precision.  The C and SSE2 kernels do the same float operations in
+   the same order, so they too agree to the bit. */
+
+#define KL_SIN_C1   6.28318530717958648f
+#define KL_SIN_C3 -41.3417022403997548f
+#define KL_SIN_C5  81.6052492760750384f
+#define KL_SIN_C7 -76.7058597530613612f
+#define KL_SIN_C9  42.0586939448976339f
+#define KL_SIN_C11 -15.0946425768229840f
+#define KL_SIN_C13  3.81995258484828039f
+
+static inline uint16_t swap16(uint16_t v)
+{
+	return (v << 8) | (v >> 8);
+}
+
+static inline uint32_t swap32(uint32_t v)
+{
+	return (v << 24) | ((v << 8) & 0xff0000) | ((v >> 8) & 0xff00) | (v >> 24);
+}
+
+void kl_tone_s16_c(const float *in, void *out, unsigned int count, float scale, int swap)
+{
+	uint8_t *dst = out;
+
+	for (unsigned int i = 0; i < count; i++) {
+		float f = in[i] * scale;
+		uint16_t v;
+
+		if (f > KL_S16_CLAMP)
+			f = KL_S16_CLAMP;
+		if (f < -KL_S16_CLAMP)
+			f = -KL_S16_CLAMP;
+		v = (int16_t)f;
+		if (swap)
+			v = swap16(v);
+		memcpy(dst + i * 2, &v, 2);
+	}
+}
+
+void kl_tone_s32_c(const float *in, void *out, unsigned int count, float scale, int swap)
+{
+	uint8_t *dst = out;
+
+	for (unsigned int i = 0; i < count; i++) {
+		float f = in[i] * scale;
+		uint32_t v;
+
+		if (f > KL_S32_CLAMP)
+			f = KL_S32_CLAMP;
+		if (f < -KL_S32_CLAMP)
+			f = -KL_S32_CLAMP;
+		v = (int32_t)f;
+		if (swap)
+			v = swap32(v);
+		memcpy(dst + i * 4, &v, 4);
+	}
+}
+
+void kl_tone_f32_c(const float *in, void *out, unsigned int count, float scale, int swap)
+{
+	uint8_t *dst = out;
+
+	for (unsigned int i = 0; i < count; i++) {
+		uint32_t v;
+
+		memcpy(&v, &in[i], 4);
+		if (swap)
+			v = swap32(v);
+		memcpy(dst + i * 4, &v, 4);
+	}
+}
+
+static inline float sin_cycles(float z)
+{
+	float s = z * z;
+	float p = KL_SIN_C13;
+
+	p = p * s + KL_SIN_C11;
+	p = p * s + KL_SIN_C9;
+	p = p * s + KL_SIN_C7;
+	p = p * s + KL_SIN_C5;
+	p = p * s + KL_SIN_C3;
+	p = p * s + KL_SIN_C1;
+	p = p * z;
+
+	/* Rounding can take the peaks a hair past full scale */
+	if (p > 1.0f)
+		p = 1.0f;
+	if (p < -1.0f)
+		p = -1.0f;
+	return p;
+}
+
+void kl_sine_fill_c(float *out, unsigned int count, uint32_t step, uint32_t modulus,
+		    uint32_t phase, float level)
+{
+	const int32_t half = modulus / 2, quarter = modulus / 4;
+	const float scale = modulus;
+
+	for (unsigned int i = 0; i < count; i++) {
+		int32_t u = phase > (uint32_t)half ? (int32_t)(phase - modulus) : (int32_t)phase;
+
+		if (u > quarter)
+			u = half - u;
+		if (u < -quarter)
+			u = -half - u;
+		out[i] = sin_cycles((float)u / scale) * level;
+
+		phase += step;
+		if (phase >= modulus)
+			phase -= modulus;
+	}
+}
+
+#if KL_HAVE_X86
+
+__attribute__((target("sse2")))
+static inline __m128i swap16_epi16(__m128i v)
+{
+	return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+__attribute__((target("sse2")))
+static inline __m128i swap32_epi32(__m128i v)
+{
+	v = swap16_epi16(v);
+	v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+	return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+__attribute__((target("sse2")))
+static inline __m128i clamp_4(const float *in, __m128 scale, float clamp)
+{
+	const __m128 hi = _mm_set1_ps(clamp);
+	const __m128 lo = _mm_set1_ps(-clamp);
+	__m128 f = _mm_mul_ps(_mm_loadu_ps(in), scale);
+
+	return _mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(f, hi), lo));
+}
+
+__attribute__((target("sse2")))
+void kl_tone_s16_sse2(const float *in, void *out, unsigned int count, float scale, int swap)
+{
+	const __m128 s = _mm_set1_ps(scale);
+	uint8_t *dst = out;
+	unsigned int i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i a = clamp_4(in + i, s, KL_S16_CLAMP);
+		__m128i b = clamp_4(in + i + 4, s, KL_S16_CLAMP);
+		__m128i v = _mm_packs_epi32(a, b);
+
+		if (swap)
+			v = swap16_epi16(v);
+		_mm_storeu_si128((__m128i *)(dst + i * 2), v);
+	}
+	kl_tone_s16_c(in + i, dst + i * 2, count - i, scale, swap);
+}
+
+__attribute__((target("sse2")))
+void kl_tone_s32_sse2(const float *in, void *out, unsigned int count, float scale, int swap)
+{
+	const __m128 s = _mm_set1_ps(scale);
+	uint8_t *dst = out;
+	unsigned int i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i v = clamp_4(in + i, s, KL_S32_CLAMP);
+
+		if (swap)
+			v = swap32_epi32(v);
+		_mm_storeu_si128((__m128i *)(dst + i * 4), v);
+	}
+	kl_tone_s32_c(in + i, dst + i * 4, count - i, scale, swap);
+}
+
+__attribute__((target("sse2")))
+void kl_tone_f32_sse2(const float *in, void *out, unsigned int count, float scale, int swap)
+{
+	uint8_t *dst = out;
+	unsigned int i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+
+		if (swap)
+			v = swap32_epi32(v);
+		_mm_storeu_si128((__m128i *)(dst + i * 4), v);
+	}
+	kl_tone_f32_c(in + i, dst + i * 4, count - i, scale, swap);
+}
+
+__attribute__((target("sse2")))
+static inline __m128i select_epi32(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+__attribute__((target("sse2")))
+void kl_sine_fill_sse2(float *out, unsigned int count, uint32_t step, uint32_t modulus,
+		       uint32_t phase, float level)
+{
+	const int32_t half = modulus / 2, quarter = modulus / 4;
+	const __m128i m = _mm_set1_epi32(modulus);
+	const __m128i h = _mm_set1_epi32(half);
+	const __m128i q = _mm_set1_epi32(quarter);
+	const __m128i nq = _mm_set1_epi32(-quarter);
+	const __m128i last = _mm_set1_epi32(modulus - 1);
+	const __m128i step4 = _mm_set1_epi32((uint64_t)step * 4 % modulus);
+	const __m128 scale = _mm_set1_ps((float)modulus);
+	const __m128 lvl = _mm_set1_ps(level);
+	uint32_t lane[4];
+	unsigned int i = 0;
+	__m128i p;
+
+	/* Phases of the first four samples, all below modulus */
+	for (int j = 0; j < 4; j++)
+		lane[j] = (phase + (uint64_t)step * j) % modulus;
+	p = _mm_loadu_si128((const __m128i *)lane);
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i u = _mm_sub_epi32(p, _mm_and_si128(_mm_cmpgt_epi32(p, h), m));
+		__m128 z, s, r;
+
+		u = select_epi32(_mm_cmpgt_epi32(u, q), _mm_sub_epi32(h, u), u);
+		u = select_epi32(_mm_cmplt_epi32(u, nq), _mm_sub_epi32(_mm_setzero_si128(),
+								       _mm_add_epi32(h, u)), u);
+
+		z = _mm_div_ps(_mm_cvtepi32_ps(u), scale);
+		s = _mm_mul_ps(z, z);
+		r = _mm_set1_ps(KL_SIN_C13);
+		r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(KL_SIN_C11));
+		r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(KL_SIN_C9));
+		r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(KL_SIN_C7));
+		r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(KL_SIN_C5));
+		r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(KL_SIN_C3));
+		r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(KL_SIN_C1));
+		r = _mm_min_ps(_mm_max_ps(_mm_mul_ps(r, z), _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+		_mm_storeu_ps(out + i, _mm_mul_ps(r, lvl));
+
+		p = _mm_add_epi32(p, step4);
+		p = _mm_sub_epi32(p, _mm_and_si128(_mm_cmpgt_epi32(p, last), m));
+	}
+	_mm_storeu_si128((__m128i *)lane, p);
+	kl_sine_fill_c(out + i, count - i, step, modulus, lane[0], level);
+}
+
+#endif /* KL_HAVE_X86 */
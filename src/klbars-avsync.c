@@ -0,0 +1,362 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KL_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define KL_HAVE_X86 0
+#endif
+
+/* A/V sync test signal and the analyzer for it.
+
+   The signal is a white frame every period, with a beep lasting
+   exactly that frame's samples.  The analyzer looks for the same two
+   things coming back: a frame whose mean luma is over half way from
+   black to white, from a luma sum of every few lines, and a short
+   window of audio whose energy jumps.  A beep is timed from its first
+   loud sample, and a flash from the first sample of its frame in the
+   cadence, so the offset between them comes out in samples. */
+
+/* Lines summed per frame, one in every KL_AVSYNC_LINE_STEP */
+#define KL_AVSYNC_LINE_STEP 4
+/* Mean 10-bit luma above which a frame counts as the flash */
+#define KL_AVSYNC_LIT ((64 + 940) / 2)
+/* Audio window, and the mean square over it that counts as the beep */
+#define KL_AVSYNC_WINDOW 32
+#define KL_AVSYNC_ENERGY 0.01
+/* A sample this loud starts the beep */
+#define KL_AVSYNC_PEAK 0.1f
+
+/* Luma sums, in 10-bit units */
+uint64_t kl_luma_sum_uyvy_c(const uint8_t *line, unsigned int pixels)
+{
+	uint64_t sum = 0;
+
+	for (unsigned int i = 0; i < pixels; i++)
+		sum += line[i * 2 + 1];
+	return sum << 2;
+}
+
+uint64_t kl_luma_sum_v210_c(const uint8_t *line, unsigned int pixels)
+{
+	/* Word and shift of each of the six luma samples in a group */
+	static const uint8_t word[6] = { 0, 1, 1, 2, 3, 3 };
+	static const uint8_t shift[6] = { 10, 0, 20, 10, 0, 20 };
+	uint64_t sum = 0;
+
+	for (unsigned int i = 0; i < pixels; i++) {
+		uint32_t w;
+
+		memcpy(&w, line + (i / 6) * 16 + word[i % 6] * 4, sizeof(w));
+		sum += (w >> shift[i % 6]) & 0x3ff;
+	}
+	return sum;
+}
+
+#if KL_HAVE_X86
+
+__attribute__((target("sse2")))
+uint64_t kl_luma_sum_uyvy_sse2(const uint8_t *line, unsigned int pixels)
+{
+	__m128i acc = _mm_setzero_si128();
+	unsigned int i = 0;
+	uint64_t sum;
+
+	/* Luma bytes moved down to the low byte of each word, and summed */
+	for (; i + 8 <= pixels; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(line + i * 2));
+		acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_srli_epi16(v, 8), _mm_setzero_si128()));
+	}
+	sum = (uint64_t)_mm_cvtsi128_si32(acc) + (uint64_t)_mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+	return (sum << 2) + kl_luma_sum_uyvy_c(line + i * 2, pixels - i);
+}
+
+__attribute__((target("sse2")))
+uint64_t kl_luma_sum_v210_sse2(const uint8_t *line, unsigned int pixels)
+{
+	const __m128i field = _mm_set1_epi32(0x3ff);
+	const __m128i even = _mm_setr_epi32(-1, 0, -1, 0);
+	const __m128i odd = _mm_setr_epi32(0, -1, 0, -1);
+	__m128i acc = _mm_setzero_si128();
+	unsigned int i = 0;
+	uint32_t lanes[4];
+
+	/* Luma is the middle field of words 0 and 2, and the outer two of
+	   words 1 and 3.  A lane gains at most 2046 a group, so 32 bits
+	   hold any line. */
+	for (; i + 6 <= pixels; i += 6) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(line + (i / 6) * 16));
+		__m128i f0 = _mm_and_si128(v, field);
+		__m128i f1 = _mm_and_si128(_mm_srli_epi32(v, 10), field);
+		__m128i f2 = _mm_and_si128(_mm_srli_epi32(v, 20), field);
+
+		acc = _mm_add_epi32(acc, _mm_and_si128(f1, even));
+		acc = _mm_add_epi32(acc, _mm_and_si128(_mm_add_epi32(f0, f2), odd));
+	}
+	_mm_storeu_si128((__m128i *)lanes, acc);
+	return (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+		kl_luma_sum_v210_c(line + (i / 6) * 16, pixels - i);
+}
+
+#endif /* KL_HAVE_X86 */
+
+int kl_colorbar_fill_avsync(struct kl_colorbar_context *ctx, unsigned int period_frames,
+			    unsigned long long frame)
+{
+	if ((!ctx) || period_frames == 0)
+		return -1;
+
+	if (frame % period_frames == 0)
+		return kl_colorbar_fill_pattern(ctx, KL_COLORBAR_WHITE);
+	return kl_colorbar_fill_pattern(ctx, KL_COLORBAR_BLACK);
+}
+
+int kl_colorbar_tonegenerator_avsync(struct kl_colorbar_audio_context *audio_ctx,
+				     const struct kl_colorbar_audio_cadence *cadence,
+				     unsigned int period_frames, int toneFreqHz,
+				     enum kl_colorbar_sample_format format, unsigned int flags,
+				     int channelCount, int sampleRate)
+{
+	size_t samples;
+	float *wave;
+
+	if ((!audio_ctx) || (!cadence) || cadence->frames == 0 || sampleRate <= 0 ||
+	    period_frames == 0 || period_frames % cadence->frames != 0)
+		return -1;
+
+	samples = (size_t)(period_frames / cadence->frames) * cadence->cycle_samples;
+	if (kl_tone_alloc(audio_ctx, format, flags, channelCount, samples) < 0)
+		return -1;
+
+	wave = calloc(samples, sizeof(float));
+	if (wave == NULL) {
+		kl_colorbar_tonegenerator_free(audio_ctx);
+		return -1;
+	}
+
+	/* A cosine, so the beep starts at its peak */
+	if (kl_tone_sine(wave, cadence->count[0], toneFreqHz, sampleRate, 1, 1.0f) < 0 ||
+	    kl_tone_set_channels(audio_ctx, 0, channelCount, wave) < 0) {
+		free(wave);
+		kl_colorbar_tonegenerator_free(audio_ctx);
+		return -1;
+	}
+	free(wave);
+	return 0;
+}
+
+int kl_colorbar_avsync_analyzer_init(struct kl_colorbar_avsync_analyzer *an,
+				     unsigned int width, unsigned int height,
+				     unsigned int stride, int colorspace,
+				     unsigned int sampleRate, unsigned int fps_num,
+				     unsigned int fps_den, enum kl_colorbar_sample_format format,
+				     unsigned int flags, unsigned int channels, unsigned int channel)
+{
+	const int big_endian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+
+	if ((!an) || width == 0 || height == 0 || channel >= channels)
+		return -1;
+	if (flags & ~KL_COLORBAR_AUDIO_BIG_ENDIAN)
+		return -1;
+	if (colorspace != KL_COLORBAR_8BIT && colorspace != KL_COLORBAR_10BIT)
+		return -1;
+	if (format != KL_COLORBAR_SAMPLE_S16 && format != KL_COLORBAR_SAMPLE_S24_32 &&
+	    format != KL_COLORBAR_SAMPLE_S32 && format != KL_COLORBAR_SAMPLE_FLOAT32)
+		return -1;
+
+	memset(an, 0, sizeof(*an));
+	if (kl_colorbar_audio_cadence_init(&an->cadence, sampleRate, fps_num, fps_den) < 0)
+		return -1;
+
+	kl_kernels_init();
+	an->width = width;
+	an->height = height;
+	an->stride = stride;
+	an->colorspace = colorspace;
+	an->sample_rate = sampleRate;
+	an->format = format;
+	an->swap = !!(flags & KL_COLORBAR_AUDIO_BIG_ENDIAN) != big_endian;
+	an->channels = channels;
+	an->channel = channel;
+	an->flash = -1;
+	an->first_peak = -1;
+	an->prev_peak = -1;
+	an->beep = -1;
+	return 0;
+}
+
+static void record(struct kl_colorbar_avsync_analyzer *an, long long flash, long long beep)
+{
+	struct kl_colorbar_avsync_stats *stats = &an->stats;
+	long long offset = beep - flash;
+
+	if (stats->measurements == 0 || offset < stats->min_offset)
+		stats->min_offset = offset;
+	if (stats->measurements == 0 || offset > stats->max_offset)
+		stats->max_offset = offset;
+	stats->offset = offset;
+	stats->measurements++;
+}
+
+/* Pair an event with the other kind's last unpaired one, if close enough,
+   or leave it waiting for one */
+static int pair(struct kl_colorbar_avsync_analyzer *an, long long at, long long *mine,
+		long long *other, int is_flash)
+{
+	long long distance = at > *other ? at - *other : *other - at;
+
+	if (*other >= 0 && distance <= an->sample_rate / 2) {
+		if (is_flash)
+			record(an, at, *other);
+		else
+			record(an, *other, at);
+		*other = -1;
+		*mine = -1;
+		return 1;
+	}
+	*mine = at;
+	return 0;
+}
+
+int kl_colorbar_avsync_analyze_frame(struct kl_colorbar_avsync_analyzer *an,
+				     const unsigned char *frame)
+{
+	kl_luma_sum_fn sum_line;
+	uint64_t sum = 0, lines = 0;
+	int lit, ret = 0;
+
+	if ((!an) || (!frame) || an->cadence.frames == 0)
+		return -1;
+
+	sum_line = an->colorspace == KL_COLORBAR_10BIT ? kl_kernels.luma_sum_v210 :
+		kl_kernels.luma_sum_uyvy;
+	for (unsigned int y = 0; y < an->height; y += KL_AVSYNC_LINE_STEP) {
+		sum += sum_line(frame + (size_t)y * an->stride, an->width);
+		lines++;
+	}
+	lit = sum > KL_AVSYNC_LIT * lines * an->width;
+
+	if (lit && !an->lit) {
+		const struct kl_colorbar_audio_cadence *c = &an->cadence;
+		long long start = an->frame / c->frames * c->cycle_samples +
+			c->first[an->frame % c->frames];
+
+		an->stats.flashes++;
+		ret = pair(an, start, &an->flash, &an->beep, 1);
+	}
+	an->lit = lit;
+	an->frame++;
+	return ret;
+}
+
+static inline uint16_t swap16(uint16_t v)
+{
+	return (v << 8) | (v >> 8);
+}
+
+static inline uint32_t swap32(uint32_t v)
+{
+	return (v << 24) | ((v << 8) & 0xff0000) | ((v >> 8) & 0xff00) | (v >> 24);
+}
+
+/* One channel of a block of samples, as floats */
+static void read_channel(const struct kl_colorbar_avsync_analyzer *an, const unsigned char *pcm,
+			 float *out, size_t count)
+{
+	const size_t stride = (size_t)an->channels * 4;
+
+	switch (an->format) {
+	case KL_COLORBAR_SAMPLE_S16:
+		pcm += an->channel * 2;
+		for (size_t i = 0; i < count; i++) {
+			uint16_t v;
+
+			memcpy(&v, pcm + i * an->channels * 2, sizeof(v));
+			if (an->swap)
+				v = swap16(v);
+			out[i] = (int16_t)v / 32768.0f;
+		}
+		break;
+	case KL_COLORBAR_SAMPLE_S24_32:
+	case KL_COLORBAR_SAMPLE_S32:
+		pcm += an->channel * 4;
+		for (size_t i = 0; i < count; i++) {
+			uint32_t v;
+
+			memcpy(&v, pcm + i * stride, sizeof(v));
+			if (an->swap)
+				v = swap32(v);
+			out[i] = (int32_t)v / (an->format == KL_COLORBAR_SAMPLE_S32 ?
+					       2147483648.0f : 8388608.0f);
+		}
+		break;
+	case KL_COLORBAR_SAMPLE_FLOAT32:
+		pcm += an->channel * 4;
+		for (size_t i = 0; i < count; i++) {
+			uint32_t v;
+
+			memcpy(&v, pcm + i * stride, sizeof(v));
+			if (an->swap)
+				v = swap32(v);
+			memcpy(&out[i], &v, sizeof(float));
+		}
+		break;
+	default:
+		memset(out, 0, count * sizeof(float));
+		break;
+	}
+}
+
+int kl_colorbar_avsync_analyze_audio(struct kl_colorbar_avsync_analyzer *an,
+				     const unsigned char *pcm, size_t sampleCount)
+{
+	size_t frame_bytes;
+	float block[256];
+	int ret = 0;
+
+	if ((!an) || (!pcm) || an->channels == 0)
+		return -1;
+
+	frame_bytes = (size_t)an->channels * (an->format == KL_COLORBAR_SAMPLE_S16 ? 2 : 4);
+
+	while (sampleCount > 0) {
+		size_t count = sampleCount < 256 ? sampleCount : 256;
+
+		read_channel(an, pcm, block, count);
+		for (size_t i = 0; i < count; i++) {
+			float x = block[i];
+
+			if (an->first_peak < 0 && fabsf(x) > KL_AVSYNC_PEAK)
+				an->first_peak = an->sample;
+			an->energy += x * x;
+			an->sample++;
+			if (++an->window < KL_AVSYNC_WINDOW)
+				continue;
+
+			/* A beep that started near the end of the last window
+			   may not have made that one loud */
+			int loud = an->energy > KL_AVSYNC_ENERGY * KL_AVSYNC_WINDOW;
+			if (loud && !an->loud) {
+				long long start = an->prev_peak >= 0 ? an->prev_peak : an->first_peak;
+
+				if (start < 0)
+					start = an->sample - KL_AVSYNC_WINDOW;
+				an->stats.beeps++;
+				ret += pair(an, start, &an->beep, &an->flash, 0);
+			}
+			an->loud = loud;
+			an->prev_peak = loud ? -1 : an->first_peak;
+			an->first_peak = -1;
+			an->energy = 0;
+			an->window = 0;
+		}
+		pcm += count * frame_bytes;
+		sampleCount -= count;
+	}
+	return ret;
+}
@@ -0,0 +1,123 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+struct replicate_job {
+	struct kl_colorbar_context *ctx;
+	const struct kl_band *bands;
+	int count;
+};
+
+/* Copy the first row of each band over the rest of it, for rows
+   [first, end) of the frame */
+static void replicate_rows(void *arg, uint32_t first, uint32_t end)
+{
+	struct replicate_job *job = arg;
+	struct kl_colorbar_context *ctx = job->ctx;
+	uint32_t rowBytes = kl_row_bytes(ctx);
+	kl_row_copy_fn copy = kl_row_copier(ctx);
+
+	for (int b = 0; b < job->count; b++) {
+		const struct kl_band *band = &job->bands[b];
+		uint8_t *start = ctx->frame + ctx->stride * band->first;
+		uint32_t y = band->first + 1;
+		uint32_t stop = band->end;
+
+		if (y < first)
+			y = first;
+		if (stop > end)
+			stop = end;
+		for (; y < stop; y++)
+			copy(ctx->frame + ctx->stride * y, start, rowBytes);
+	}
+}
+
+/* Every pattern is made of horizontal bands, where all the rows of a
+   band are identical.  Only the first row of each band is drawn, and
+   the rest are copies of it. */
+int kl_fill_bands(struct kl_colorbar_context *ctx, const struct kl_band *bands,
+		  int count)
+{
+	struct replicate_job job = { ctx, bands, count };
+
+	for (int b = 0; b < count; b++) {
+		if (bands[b].first >= bands[b].end)
+			continue;
+		if (kl_pattern_raster(ctx, bands[b].desc, bands[b].first) < 0)
+			return -1;
+	}
+
+	kl_workers_run(ctx, replicate_rows, &job, ctx->height, kl_row_bytes(ctx));
+
+	kl_mark_rows(ctx, 0, ctx->height, KL_ROW_DIRTY);
+	kl_clear_rows(ctx, 0, ctx->height, KL_ROW_OVERLAY | KL_ROW_COUNTER);
+	return 0;
+}
+
+/* The frame already holds the same pattern, apart from the rows which
+   were drawn over since.  Put back just those rows, copying from a
+   clean row of the same band when there is one.  Rows holding counters
+   are left as they are, see klbars-counter.c. */
+int kl_restore_bands(struct kl_colorbar_context *ctx, const struct kl_band *bands,
+		     int count)
+{
+	uint32_t rowBytes = kl_row_bytes(ctx);
+	unsigned char *flags = ctx->rowflags;
+
+	for (int b = 0; b < count; b++) {
+		const struct kl_band *band = &bands[b];
+		uint32_t src = band->end;
+		int overlaid = 0;
+
+		for (uint32_t y = band->first; y < band->end; y++) {
+			if (flags[y] & KL_ROW_OVERLAY)
+				overlaid = 1;
+			else if (src == band->end && !(flags[y] & KL_ROW_COUNTER))
+				src = y;
+		}
+		if (!overlaid)
+			continue;
+
+		if (src == band->end) {
+			src = band->first;
+			if (kl_pattern_raster(ctx, band->desc, src) < 0)
+				return -1;
+			flags[src] = KL_ROW_DIRTY;
+		}
+
+		for (uint32_t y = band->first; y < band->end; y++) {
+			if (!(flags[y] & KL_ROW_OVERLAY))
+				continue;
+			memcpy(ctx->frame + ctx->stride * y,
+			       ctx->frame + ctx->stride * src, rowBytes);
+			flags[y] = KL_ROW_DIRTY;
+		}
+	}
+	return 0;
+}
+
+void kl_mark_rows(struct kl_colorbar_context *ctx, uint32_t first,
+		  uint32_t count, unsigned char flags)
+{
+	if (!ctx->rowflags || first >= ctx->height)
+		return;
+
+	if (count > ctx->height - first)
+		count = ctx->height - first;
+	for (uint32_t y = first; y < first + count; y++)
+		ctx->rowflags[y] |= flags;
+}
+
+void kl_clear_rows(struct kl_colorbar_context *ctx, uint32_t first,
+		   uint32_t count, unsigned char flags)
+{
+	if (!ctx->rowflags || first >= ctx->height)
+		return;
+
+	if (count > ctx->height - first)
+		count = ctx->height - first;
+	for (uint32_t y = first; y < first + count; y++)
+		ctx->rowflags[y] &= ~flags;
+}
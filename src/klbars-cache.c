@@ -0,0 +1,308 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Process wide cache of fully rendered patterns.
+
+   Contexts with the cache enabled don't fill a frame of their own.
+   Instead they point ctx->frame at the shared, read-only rendering of
+   the pattern, and only make a private copy once text is drawn over
+   it.  Entries are refcounted, and unreferenced entries stay around
+   for as long as any context has the cache enabled, so alternating
+   between patterns (or RP 198 polarities) doesn't re-render them. */
+
+struct kl_pattern_cache_entry {
+	struct kl_pattern_cache_entry *next;
+
+	/* Key */
+	int pattern;
+	unsigned int width, height;
+	int colorspace;
+	int polarity;
+
+	unsigned int stride;
+	unsigned char *data;
+	int refcount;
+};
+
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct kl_pattern_cache_entry *cache_head;
+static int cache_users;
+
+/* Only the RP 198 polarity word changes from frame to frame, and only
+   in the first row */
+static int pattern_polarity(struct kl_colorbar_context *ctx, int pattern)
+{
+	return pattern == KL_COLORBAR_SMPTE_RP_198 && ctx->pic_count % 2 == 0;
+}
+
+#define KL_POLARITY_ROW 0
+
+/* Same pattern and geometry, so the two differ in the polarity row at most */
+static int same_pattern(const struct kl_pattern_cache_entry *a,
+			const struct kl_pattern_cache_entry *b)
+{
+	return a && b && a->pattern == b->pattern && a->width == b->width &&
+		a->height == b->height && a->colorspace == b->colorspace;
+}
+
+static int render_entry(struct kl_pattern_cache_entry *e, unsigned short *line)
+{
+	struct kl_colorbar_context tmp;
+	struct kl_band bands[KL_MAX_BANDS];
+	int count;
+
+	memset(&tmp, 0, sizeof(tmp));
+	tmp.width = e->width;
+	tmp.height = e->height;
+	tmp.colorspace = e->colorspace;
+	tmp.stride = e->stride;
+	tmp.frame = e->data;
+	tmp.pic_count = e->polarity ? 0 : 1;
+	tmp.fill_pattern = -1;
+	tmp.raster_line = line;
+
+	count = kl_pattern_bands(&tmp, e->pattern, bands);
+	if (count < 0)
+		return -1;
+
+	if (kl_fill_bands(&tmp, bands, count) < 0)
+		return -1;
+	if (e->pattern == KL_COLORBAR_SMPTE_RP_198)
+		kl_colorbar_rp198_polarity(&tmp);
+
+	return 0;
+}
+
+static void free_entry_locked(struct kl_pattern_cache_entry *e)
+{
+	struct kl_pattern_cache_entry **pp;
+
+	for (pp = &cache_head; *pp; pp = &(*pp)->next) {
+		if (*pp == e) {
+			*pp = e->next;
+			break;
+		}
+	}
+	free(e->data);
+	free(e);
+}
+
+static struct kl_pattern_cache_entry *cache_acquire(struct kl_colorbar_context *ctx,
+						    int pattern)
+{
+	struct kl_pattern_cache_entry *e;
+	int polarity = pattern_polarity(ctx, pattern);
+
+	pthread_mutex_lock(&cache_lock);
+	for (e = cache_head; e; e = e->next) {
+		if (e->pattern == pattern && e->width == ctx->width &&
+		    e->height == ctx->height && e->colorspace == ctx->colorspace &&
+		    e->polarity == polarity) {
+			e->refcount++;
+			pthread_mutex_unlock(&cache_lock);
+			return e;
+		}
+	}
+
+	/* Not rendered yet.  This holds the lock while rendering, but any
+	   other context after the same pattern would have to wait for it
+	   anyway. */
+	e = calloc(1, sizeof(*e));
+	if (e == NULL)
+		goto fail;
+
+	e->pattern = pattern;
+	e->width = ctx->width;
+	e->height = ctx->height;
+	e->colorspace = ctx->colorspace;
+	e->polarity = polarity;
+	e->stride = kl_row_bytes(ctx);
+	e->data = calloc(e->height, e->stride);
+	if (e->data == NULL || render_entry(e, ctx->raster_line) < 0) {
+		free(e->data);
+		free(e);
+		goto fail;
+	}
+
+	e->refcount = 1;
+	e->next = cache_head;
+	cache_head = e;
+	pthread_mutex_unlock(&cache_lock);
+	return e;
+
+fail:
+	pthread_mutex_unlock(&cache_lock);
+	return NULL;
+}
+
+static void cache_release(struct kl_pattern_cache_entry *e)
+{
+	if (!e)
+		return;
+
+	pthread_mutex_lock(&cache_lock);
+	if (--e->refcount == 0 && cache_users == 0)
+		free_entry_locked(e);
+	pthread_mutex_unlock(&cache_lock);
+}
+
+/* Copy rows of a cache entry into the context's own frame.  With dirty
+   tracking, and a frame which already holds 'from' (or its other
+   polarity), only the rows drawn over since need to be copied. */
+static void copy_from_entry(struct kl_colorbar_context *ctx,
+			    const struct kl_pattern_cache_entry *from,
+			    const struct kl_pattern_cache_entry *e,
+			    int mark_dirty)
+{
+	uint32_t rowBytes = kl_row_bytes(ctx);
+	int partial = ctx->rowflags && same_pattern(from, e);
+
+	for (uint32_t y = 0; y < ctx->height; y++) {
+		if (partial && !(ctx->rowflags[y] & KL_ROW_OVERLAY) &&
+		    !(y == KL_POLARITY_ROW && from != e))
+			continue;
+		memcpy(ctx->frame + ctx->stride * y, e->data + e->stride * y, rowBytes);
+		kl_clear_rows(ctx, y, 1, KL_ROW_COUNTER);
+		if (mark_dirty)
+			kl_mark_rows(ctx, y, 1, KL_ROW_DIRTY);
+	}
+	kl_clear_rows(ctx, 0, ctx->height, KL_ROW_OVERLAY);
+}
+
+int kl_cache_fill(struct kl_colorbar_context *ctx, int pattern)
+{
+	struct kl_pattern_cache_entry *prev = ctx->cache_entry;
+	struct kl_pattern_cache_entry *e;
+
+	e = cache_acquire(ctx, pattern);
+	if (e == NULL)
+		return -1;
+
+	if (ctx->external) {
+		/* Caller owned frame, so it has to be written to */
+		copy_from_entry(ctx, ctx->fill_pattern == pattern ? prev : NULL, e, 1);
+	} else {
+		/* Rows with text on them change back to the pattern */
+		if (ctx->frame == ctx->private_frame && ctx->rowflags) {
+			for (uint32_t y = 0; y < ctx->height; y++) {
+				if (ctx->rowflags[y] & KL_ROW_OVERLAY)
+					ctx->rowflags[y] |= KL_ROW_DIRTY;
+			}
+		}
+		if (same_pattern(prev, e)) {
+			if (prev != e)
+				kl_mark_rows(ctx, KL_POLARITY_ROW, 1, KL_ROW_DIRTY);
+		} else {
+			kl_mark_rows(ctx, 0, ctx->height, KL_ROW_DIRTY);
+		}
+
+		ctx->frame = e->data;
+		ctx->stride = e->stride;
+	}
+
+	ctx->cache_entry = e;
+	cache_release(prev);
+	ctx->fill_pattern = pattern;
+
+	return 0;
+}
+
+/* About to draw into the frame, so stop sharing it */
+int kl_cache_make_private(struct kl_colorbar_context *ctx)
+{
+	struct kl_pattern_cache_entry *e = ctx->cache_entry;
+	struct kl_pattern_cache_entry *from = ctx->private_src;
+
+	if (!ctx->use_cache || ctx->external)
+		return 0;
+
+	if (e == NULL || ctx->frame != e->data)
+		return ctx->frame ? 0 : -1;
+
+	if (ctx->private_frame == NULL) {
+		ctx->private_frame = malloc(ctx->height * e->stride);
+		if (ctx->private_frame == NULL)
+			return -1;
+		from = NULL;
+	}
+
+	ctx->frame = ctx->private_frame;
+	ctx->stride = e->stride;
+	copy_from_entry(ctx, from, e, 0);
+
+	pthread_mutex_lock(&cache_lock);
+	e->refcount++;
+	pthread_mutex_unlock(&cache_lock);
+	cache_release(ctx->private_src);
+	ctx->private_src = e;
+
+	return 0;
+}
+
+void kl_cache_detach(struct kl_colorbar_context *ctx)
+{
+	struct kl_pattern_cache_entry *e, *next;
+
+	cache_release(ctx->cache_entry);
+	cache_release(ctx->private_src);
+	ctx->cache_entry = NULL;
+	ctx->private_src = NULL;
+
+	/* Last user gone, drop whatever nobody references */
+	pthread_mutex_lock(&cache_lock);
+	if (--cache_users == 0) {
+		for (e = cache_head; e; e = next) {
+			next = e->next;
+			if (e->refcount == 0)
+				free_entry_locked(e);
+		}
+	}
+	pthread_mutex_unlock(&cache_lock);
+}
+
+int kl_colorbar_set_pattern_cache(struct kl_colorbar_context *ctx, int enable)
+{
+	if (!ctx)
+		return -1;
+
+	enable = !!enable;
+	if (enable == ctx->use_cache)
+		return 0;
+
+	if (enable) {
+		pthread_mutex_lock(&cache_lock);
+		cache_users++;
+		pthread_mutex_unlock(&cache_lock);
+
+		/* Our own frame is only needed again once text is drawn */
+		if (!ctx->external) {
+			free(ctx->frame);
+			ctx->frame = NULL;
+			ctx->private_frame = NULL;
+		}
+		ctx->use_cache = 1;
+		ctx->fill_pattern = -1;
+		return 0;
+	}
+
+	/* Keep whatever is currently shown, in a frame of our own */
+	if (!ctx->external) {
+		if (ctx->frame == NULL) {
+			ctx->stride = kl_row_bytes(ctx);
+			ctx->frame = malloc(ctx->height * ctx->stride);
+			if (ctx->frame == NULL)
+				return -1;
+		} else if (kl_cache_make_private(ctx) < 0) {
+			return -1;
+		}
+		ctx->private_frame = NULL;
+	}
+	kl_cache_detach(ctx);
+	ctx->use_cache = 0;
+	ctx->fill_pattern = -1;
+	return 0;
+}
@@ -0,0 +1,150 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Audio samples per video frame.
+
+   With rate samples a second and num/den frames, frame n starts at
+   n * rate * den / num samples, rounded.  That pattern repeats every
+   num / gcd(rate * den, num) frames, so one cycle of counts is worked
+   out up front and a frame is found from its place in the cycle.
+   Frames asked for in order just step on from the last one, with no
+   division at all. */
+
+int kl_colorbar_audio_cadence_init(struct kl_colorbar_audio_cadence *cadence,
+				   unsigned int sampleRate, unsigned int fps_num,
+				   unsigned int fps_den)
+{
+	uint64_t per_frame, frames, prev = 0;
+
+	if ((!cadence) || sampleRate == 0 || fps_num == 0 || fps_den == 0)
+		return -1;
+
+	/* Samples per frame are per_frame / fps_num */
+	per_frame = (uint64_t)sampleRate * fps_den;
+	if (per_frame > UINT64_MAX / (KL_COLORBAR_CADENCE_MAX + 1))
+		return -1;
+	frames = fps_num / kl_gcd64(per_frame, fps_num);
+	if (frames > KL_COLORBAR_CADENCE_MAX || per_frame * frames / fps_num > UINT32_MAX)
+		return -1;
+
+	memset(cadence, 0, sizeof(*cadence));
+	cadence->frames = frames;
+	cadence->cycle_samples = per_frame * frames / fps_num;
+	for (unsigned int i = 0; i < frames; i++) {
+		uint64_t next = ((i + 1) * per_frame + fps_num / 2) / fps_num;
+
+		cadence->first[i] = prev;
+		cadence->count[i] = next - prev;
+		prev = next;
+	}
+	return 0;
+}
+
+/* Bytes per sample of every channel, as a cursor counts them */
+static size_t sample_stride(const struct kl_colorbar_audio_context *audio_ctx)
+{
+	if (audio_ctx->flags & KL_COLORBAR_AUDIO_PLANAR)
+		return audio_ctx->sample_bytes;
+	return (size_t)audio_ctx->sample_bytes * audio_ctx->channels;
+}
+
+/* Where frame's audio starts in the tone, and which count of the
+   cycle it has */
+static void frame_start(const struct kl_colorbar_audio_context *audio_ctx,
+			const struct kl_colorbar_audio_cadence *cadence,
+			unsigned long long frame, unsigned int *index, size_t *location)
+{
+	if (cadence->tone == audio_ctx && frame == cadence->next_frame) {
+		*index = cadence->next_index;
+		*location = cadence->next_location;
+	} else {
+		/* Where the frame's first sample falls in the tone's loop */
+		uint64_t cycles = frame / cadence->frames % audio_ctx->samples;
+		uint64_t start;
+
+		*index = frame % cadence->frames;
+		start = (cycles * (cadence->cycle_samples % audio_ctx->samples) +
+			 cadence->first[*index]) % audio_ctx->samples;
+		*location = start * sample_stride(audio_ctx);
+	}
+}
+
+/* Ready for the frame after */
+static void frame_done(const struct kl_colorbar_audio_context *audio_ctx,
+		       struct kl_colorbar_audio_cadence *cadence,
+		       unsigned long long frame, unsigned int index, size_t location)
+{
+	size_t stride = sample_stride(audio_ctx);
+	size_t loop = audio_ctx->samples * stride;
+
+	cadence->tone = audio_ctx;
+	cadence->next_frame = frame + 1;
+	cadence->next_index = index + 1 == cadence->frames ? 0 : index + 1;
+	cadence->next_location = (location + cadence->count[index] % audio_ctx->samples * stride) %
+				 loop;
+}
+
+int kl_colorbar_tonegenerator_frame(struct kl_colorbar_audio_context *audio_ctx,
+				    struct kl_colorbar_audio_cadence *cadence,
+				    unsigned long long frame, struct kl_colorbar_audio_span *spans,
+				    unsigned int *sampleCount)
+{
+	struct kl_colorbar_audio_cursor cursor;
+	unsigned int index;
+	int count;
+
+	if ((!audio_ctx) || (!cadence) || (!spans) || (!sampleCount) ||
+	    audio_ctx->samples == 0 || cadence->frames == 0)
+		return -1;
+
+	frame_start(audio_ctx, cadence, frame, &index, &cursor.location);
+	if (cadence->count[index] > audio_ctx->samples)
+		return -1;
+	count = kl_colorbar_tonegenerator_peek(audio_ctx, &cursor,
+					       cadence->count[index] * sample_stride(audio_ctx),
+					       spans);
+	if (count < 0)
+		return -1;
+	*sampleCount = cadence->count[index];
+
+	frame_done(audio_ctx, cadence, frame, index, cursor.location);
+	return count;
+}
+
+int kl_colorbar_tonegenerator_extract_frame(struct kl_colorbar_audio_context *audio_ctx,
+					    struct kl_colorbar_audio_cadence *cadence,
+					    unsigned long long frame, unsigned char *buf)
+{
+	struct kl_colorbar_audio_span spans[2];
+	struct kl_colorbar_audio_cursor cursor;
+	unsigned int index;
+	size_t start, left;
+
+	if ((!audio_ctx) || (!cadence) || (!buf) || audio_ctx->samples == 0 ||
+	    cadence->frames == 0 || (audio_ctx->flags & KL_COLORBAR_AUDIO_PLANAR))
+		return -1;
+
+	frame_start(audio_ctx, cadence, frame, &index, &cursor.location);
+	start = cursor.location;
+
+	/* A frame longer than the loop goes round it more than once */
+	left = cadence->count[index] * sample_stride(audio_ctx);
+	while (left > 0) {
+		int count = kl_colorbar_tonegenerator_peek(audio_ctx, &cursor, left, spans);
+
+		if (count < 0)
+			return -1;
+		for (int i = 0; i < count; i++) {
+			memcpy(buf, spans[i].data, spans[i].size);
+			buf += spans[i].size;
+			left -= spans[i].size;
+			kl_colorbar_tonegenerator_advance(audio_ctx, &cursor, spans[i].size);
+		}
+	}
+
+	frame_done(audio_ctx, cadence, frame, index, start);
+	return cadence->count[index];
+}
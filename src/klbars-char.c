@@ -3,7 +3,6 @@
 #include <stdlib.h>
 #include "libklbars/klbars.h"
 #include "klbars-internal.h"
-#include "font8x8_basic.h"
 
 int kl_colorbar_render_moveto(struct kl_colorbar_context *ctx, int x, int y)
 {
@@ -27,135 +26,229 @@ int kl_colorbar_render_moveto(struct kl_colorbar_context *ctx, int x, int y)
 	return 0;
 }
 
-static int kl_colorbar_render_character_8bit(struct kl_colorbar_context *ctx, uint8_t letter)
+/* Glyphs drawn so far, already in the frame's format and in the current
+   colours and scale.  Drawing a character is then just a copy of each
+   of its 8 rows, repeated down the cell, or a blend of them when the
+   background is translucent.  For that each glyph also has a mask,
+   set over the bytes of the text itself. */
+
+#define KL_GLYPH_COUNT 0xa0
+
+struct kl_glyph_cache {
+	/* Key */
+	int colorspace;
+	int plotctrl;
+	uint8_t fg[2], bg[2];
+
+	uint8_t bar10_fg[16];
+	uint8_t bar10_bg[16];
+	unsigned int row_bytes; /* One font row of a glyph */
+	uint8_t ready[KL_GLYPH_COUNT];
+	uint8_t *data; /* 8 rows for each of KL_GLYPH_COUNT glyphs */
+	uint8_t *masks; /* Laid out as data */
+};
+
+static struct kl_glyph_cache *glyph_cache(struct kl_colorbar_context *ctx)
 {
-	uint8_t line;
-    
-	if (letter > 0x9f)
-		return -1;
-    
-	for (int i = 0; i < 8; i++) {
-		int k = 0;
-		while (k++ < 4) {
-			line = font8x8_basic[letter][ i ];
-			for (int j = 0; j < 8; j++) {
-				if (line & 0x01) {
-					/* font color */
-					*(ctx->ptr + 0) = ctx->fg[0];
-					*(ctx->ptr + 1) = ctx->fg[1];
-					*(ctx->ptr + 2) = ctx->fg[0];
-					*(ctx->ptr + 3) = ctx->fg[1];
-					if (ctx->plotctrl == 8) {
-						*(ctx->ptr + 4) = ctx->fg[0];
-						*(ctx->ptr + 5) = ctx->fg[1];
-						*(ctx->ptr + 6) = ctx->fg[0];
-						*(ctx->ptr + 7) = ctx->fg[1];
-					}
-				} else {
-					/* background color */
-#if ALPHA_BACKGROUND
-					/* Minor alpha */
-					*(ctx->ptr + 0) >>= 1;
-					*(ctx->ptr + 2) >>= 1;
-					*(ctx->ptr + 4) >>= 1;
-					*(ctx->ptr + 6) >>= 1;
-#else
-					/* Complete black background */
-					*(ctx->ptr + 0) = ctx->bg[0];
-					*(ctx->ptr + 1) = ctx->bg[1];
-					*(ctx->ptr + 2) = ctx->bg[0];
-					*(ctx->ptr + 3) = ctx->bg[1];
-					if (ctx->plotctrl == 8) {
-						*(ctx->ptr + 4) = ctx->bg[0];
-						*(ctx->ptr + 5) = ctx->bg[1];
-						*(ctx->ptr + 6) = ctx->bg[0];
-						*(ctx->ptr + 7) = ctx->bg[1];
-					}
-#endif
-				}
-                
-				ctx->ptr += ctx->plotctrl;
-				line >>= 1;
-			}
-			ctx->ptr += ((ctx->stride) - (ctx->plotctrl * 2 * 4));
+	struct kl_glyph_cache *gc = ctx->glyphs;
+	unsigned int row_bytes = ctx->plotctrl * 8;
+
+	if (ctx->colorspace == KL_COLORBAR_10BIT)
+		row_bytes *= 2;
+
+	if (gc && gc->colorspace == ctx->colorspace && gc->plotctrl == ctx->plotctrl &&
+	    memcmp(gc->fg, ctx->fg, 2) == 0 && memcmp(gc->bg, ctx->bg, 2) == 0)
+		return gc;
+
+	if (gc == NULL) {
+		gc = calloc(1, sizeof(*gc));
+		if (gc == NULL)
+			return NULL;
+		ctx->glyphs = gc;
+	}
+
+	if (gc->data == NULL || gc->row_bytes != row_bytes) {
+		free(gc->data);
+		free(gc->masks);
+		gc->data = malloc(KL_GLYPH_COUNT * 8 * row_bytes);
+		gc->masks = malloc(KL_GLYPH_COUNT * 8 * row_bytes);
+		if (gc->data == NULL || gc->masks == NULL) {
+			kl_glyph_cache_free(ctx);
+			return NULL;
 		}
+		gc->row_bytes = row_bytes;
 	}
-    
-	return 0;
+
+	gc->colorspace = ctx->colorspace;
+	gc->plotctrl = ctx->plotctrl;
+	memcpy(gc->fg, ctx->fg, 2);
+	memcpy(gc->bg, ctx->bg, 2);
+	memset(gc->ready, 0, sizeof(gc->ready));
+
+	if (ctx->colorspace == KL_COLORBAR_10BIT) {
+		compute_colorbar_10bit_array(ctx->fg[0] | (ctx->fg[1] << 8) |
+					     (ctx->fg[0] << 16) | ((uint32_t)ctx->fg[1] << 24),
+					     &gc->bar10_fg[0]);
+		compute_colorbar_10bit_array(ctx->bg[0] | (ctx->bg[1] << 8) |
+					     (ctx->bg[0] << 16) | ((uint32_t)ctx->bg[1] << 24),
+					     &gc->bar10_bg[0]);
+	}
+
+	return gc;
 }
 
-static int kl_colorbar_render_character_10bit(struct kl_colorbar_context *ctx, uint8_t letter)
+static struct kl_glyph_cache *glyph_lookup(struct kl_colorbar_context *ctx,
+					    uint8_t letter)
 {
-	uint8_t line;
-	uint8_t bar10_fg[16];
-	uint8_t bar10_bg[16];
+	static const uint8_t ones[16] = {
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+	};
+	static const uint8_t zeros[16];
+	struct kl_glyph_cache *gc = glyph_cache(ctx);
+	size_t offset;
+
+	if (gc == NULL || gc->ready[letter])
+		return gc;
+
+	offset = letter * 8 * gc->row_bytes;
+	if (ctx->colorspace == KL_COLORBAR_8BIT) {
+		kl_kernels.glyph_uyvy(gc->data + offset, gc->row_bytes, letter,
+				      ctx->plotctrl, 1, ctx->fg, ctx->bg);
+		kl_kernels.glyph_uyvy(gc->masks + offset, gc->row_bytes, letter,
+				      ctx->plotctrl, 1, ones, zeros);
+	} else {
+		kl_kernels.glyph_v210(gc->data + offset, gc->row_bytes, letter,
+				      ctx->plotctrl, 1, gc->bar10_fg, gc->bar10_bg);
+		kl_kernels.glyph_v210(gc->masks + offset, gc->row_bytes, letter,
+				      ctx->plotctrl, 1, ones, zeros);
+	}
+	gc->ready[letter] = 1;
+
+	return gc;
+}
+
+void kl_glyph_cache_free(struct kl_colorbar_context *ctx)
+{
+	if (ctx->glyphs == NULL)
+		return;
+
+	free(ctx->glyphs->data);
+	free(ctx->glyphs->masks);
+	free(ctx->glyphs);
+	ctx->glyphs = NULL;
+}
+
+static int kl_colorbar_render_character(struct kl_colorbar_context *ctx, uint8_t letter)
+{
+	struct kl_glyph_cache *gc;
+	const uint8_t *rows, *masks;
+	unsigned int row_bytes;
+	int repeat = ctx->plotheight / 8;
+	uint8_t *dst = ctx->ptr;
+	kl_blend_fn blend = ctx->colorspace == KL_COLORBAR_10BIT ?
+		kl_kernels.blend_v210 : kl_kernels.blend_uyvy;
 
 	if (letter > 0x9f)
 		return -1;
 
-	compute_colorbar_10bit_array(ctx->fg[0] | (ctx->fg[1] << 8) |
-				     (ctx->fg[0] << 16) | (ctx->fg[1] << 24),
-				     &bar10_fg[0]);
+	gc = glyph_lookup(ctx, letter);
+	if (gc == NULL)
+		return -1;
+	row_bytes = gc->row_bytes;
+	rows = gc->data + letter * 8 * row_bytes;
+	masks = gc->masks + letter * 8 * row_bytes;
 
-	compute_colorbar_10bit_array(ctx->bg[0] | (ctx->bg[1] << 8) |
-				     (ctx->bg[0] << 16) | (ctx->bg[1] << 24),
-				     &bar10_bg[0]);
+	if (ctx->text_alpha >= KL_TEXT_OPAQUE) {
+		for (int i = 0; i < 8; i++) {
+			for (int k = 0; k < repeat; k++) {
+				memcpy(dst, rows, row_bytes);
+				dst += ctx->stride;
+			}
+			rows += row_bytes;
+		}
+		return 0;
+	}
 
+	/* The lines a font row is repeated over are usually the same band
+	   of the pattern, in which case the blend of the first one can
+	   just be copied to the rest */
 	for (int i = 0; i < 8; i++) {
-		int k = 0;
-		while (k++ < 4) {
-			line = font8x8_basic[letter][ i ];
-			for (int j = 0; j < 4; j++) {
-				/* Hack which takes advantage of the fact that
-				   both the FG and BG have the same chroma */
-				for (int c=0; c < 2; c++) {
-					if (line & 0x01) {
-						for (int n = 0; n < 8; n++)
-							*(ctx->ptr + n) = bar10_fg[n];
-						if (ctx->plotctrl == 8) {
-							for (int n = 0; n < 8; n++)
-								*(ctx->ptr + 8 + n) = bar10_fg[n];
-						}
-					} else {
-						for (int n = 0; n < 8; n++)
-							*(ctx->ptr + n) = bar10_bg[n];
-						if (ctx->plotctrl == 8) {
-							for (int n = 0; n < 8; n++)
-								*(ctx->ptr + 8 + n) = bar10_bg[n];
-						}
-					}
-					line >>= 1;
-					ctx->ptr += ctx->plotctrl * 2;
-				}
-			}
-			ctx->ptr += ((ctx->stride) - (ctx->plotctrl * 4 * 4));
+		uint32_t same = 0;
+
+		for (int k = 1; k < repeat; k++) {
+			uint8_t *line = dst + k * ctx->stride;
+
+			if (memcmp(line, dst, row_bytes) == 0)
+				same |= 1u << k;
+			else
+				blend(line, rows, masks, row_bytes, ctx->text_alpha);
 		}
+		blend(dst, rows, masks, row_bytes, ctx->text_alpha);
+		for (int k = 1; k < repeat; k++) {
+			if (same & (1u << k))
+				memcpy(dst + k * ctx->stride, dst, row_bytes);
+		}
+
+		dst += repeat * ctx->stride;
+		rows += row_bytes;
+		masks += row_bytes;
 	}
 	return 0;
 }
 
-static int kl_colorbar_render_ascii(struct kl_colorbar_context *ctx, uint8_t letter, int x, int y)
+int kl_colorbar_render_ascii(struct kl_colorbar_context *ctx, uint8_t letter, int x, int y)
 {
 	if (letter > 0x9f)
 		return -1;
     
 	kl_colorbar_render_moveto(ctx, x, y);
 
-	if (ctx->colorspace == KL_COLORBAR_8BIT)
-		kl_colorbar_render_character_8bit(ctx, letter);
-	else
-		kl_colorbar_render_character_10bit(ctx, letter);
-    
-	return 0;
+	return kl_colorbar_render_character(ctx, letter);
 }
 
 int kl_colorbar_render_string(struct kl_colorbar_context *ctx, char *s, unsigned int len, unsigned int x, unsigned int y)
 {
+	unsigned int cell;
+
 	if ((!ctx) || (!s) || (len == 0) || (len > 128))
 		return -1;
+
+	/* The whole string has to fit in the frame */
+	cell = ctx->plotwidth * (ctx->colorspace == KL_COLORBAR_10BIT ? 4 : 2);
+	if (((uint64_t)x + len) * cell > kl_row_bytes(ctx) ||
+	    ((uint64_t)y + 1) * ctx->plotheight > ctx->height)
+		return -1;
+
+	/* Don't draw over a pattern shared with other contexts */
+	if (kl_cache_make_private(ctx) < 0)
+		return -1;
     
 	for (unsigned int i = 0; i < len; i++)
 		kl_colorbar_render_ascii(ctx, *(s + i), x + i, y);
+
+	kl_mark_rows(ctx, y * ctx->plotheight, ctx->plotheight,
+		     KL_ROW_DIRTY | KL_ROW_OVERLAY);
     
 	return 0;
 }
+
+int kl_colorbar_set_text_background(struct kl_colorbar_context *ctx, unsigned int alpha)
+{
+	if ((!ctx) || (alpha > 255))
+		return -1;
+
+	alpha = (alpha * KL_TEXT_OPAQUE + 127) / 255;
+	if (alpha == (unsigned int)ctx->text_alpha)
+		return 0;
+
+	/* Blending over a counter's last value would show through, so
+	   have the next fill put the pattern back under them first */
+	for (uint32_t y = 0; ctx->rowflags && y < ctx->height; y++) {
+		if (ctx->rowflags[y] & KL_ROW_COUNTER)
+			ctx->rowflags[y] = (ctx->rowflags[y] & ~KL_ROW_COUNTER) | KL_ROW_OVERLAY;
+	}
+
+	ctx->text_alpha = alpha;
+	return 0;
+}
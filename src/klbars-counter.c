@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Frame number and timecode burn-in, drawn by kl_colorbar_finalize().
+
+   Consecutive values differ in the last digit or two, so only the cells
+   whose character changed are redrawn.  That needs the frame to still
+   hold what was drawn last time, which is what KL_ROW_COUNTER tracks:
+   the pattern fills leave those rows alone, and clear the flag on any
+   row they do write.  Without dirty tracking there is no way to tell,
+   and every cell is drawn on every frame.  The same goes for a
+   translucent text background, which can only be drawn over a clean
+   pattern, so then the fills restore the counter rows as they do for
+   any other text. */
+
+#define KL_MAX_COUNTERS 8
+#define KL_COUNTER_MAX_CHARS 16
+
+struct kl_counter {
+	enum kl_colorbar_counter type;
+	unsigned int x, y;
+	unsigned int fps_num, fps_den;
+	char shown[KL_COUNTER_MAX_CHARS + 1]; /* What the frame holds */
+};
+
+struct kl_counters {
+	int count;
+	struct kl_counter c[KL_MAX_COUNTERS];
+};
+
+/* SMPTE 12M drop frame counting, where the first 2 frame numbers of
+   every minute not divisible by ten are skipped (4 at 59.94) */
+static void format_timecode(const struct kl_counter *c, unsigned int frame,
+			    char *text)
+{
+	unsigned int fps = (c->fps_num + c->fps_den / 2) / c->fps_den;
+	int drop = c->fps_den == 1001 && fps % 30 == 0;
+	uint64_t n = frame;
+
+	if (drop) {
+		unsigned int d = fps / 30 * 2;
+		unsigned int per_10min = fps * 600 - d * 9;
+		unsigned int per_min = fps * 60 - d;
+		uint64_t tens = n / per_10min;
+		unsigned int rem = n % per_10min;
+
+		n += d * 9 * tens;
+		if (rem > d)
+			n += d * ((rem - d) / per_min);
+	}
+
+	/* Timecode wraps at 24 hours */
+	n %= (uint64_t)fps * 86400;
+
+	snprintf(text, KL_COUNTER_MAX_CHARS + 1, "%02u:%02u:%02u%c%02u",
+		 (uint8_t)(n / fps / 3600), (uint8_t)(n / fps / 60 % 60),
+		 (uint8_t)(n / fps % 60), drop ? ';' : ':', (uint8_t)(n % fps));
+}
+
+static void format_counter(const struct kl_counter *c, unsigned int frame,
+			   char *text)
+{
+	if (c->type == KL_COLORBAR_COUNTER_TIMECODE)
+		format_timecode(c, frame, text);
+	else
+		snprintf(text, KL_COUNTER_MAX_CHARS + 1, "%08u", frame);
+}
+
+/* The frame still holds c->shown, and nothing was drawn over it */
+static int counter_intact(struct kl_colorbar_context *ctx, const struct kl_counter *c)
+{
+	uint32_t first = c->y * ctx->plotheight;
+
+	if (!ctx->rowflags || c->shown[0] == '\0')
+		return 0;
+
+	for (uint32_t y = first; y < first + ctx->plotheight; y++) {
+		if ((ctx->rowflags[y] & (KL_ROW_COUNTER | KL_ROW_OVERLAY)) != KL_ROW_COUNTER)
+			return 0;
+	}
+	return 1;
+}
+
+int kl_counters_draw(struct kl_colorbar_context *ctx)
+{
+	struct kl_counters *set = ctx->counters;
+	int opaque = ctx->text_alpha >= KL_TEXT_OPAQUE;
+	int intact[KL_MAX_COUNTERS];
+
+	if (set == NULL || set->count == 0)
+		return 0;
+
+	/* Don't draw over a pattern shared with other contexts */
+	if (kl_cache_make_private(ctx) < 0)
+		return -1;
+
+	/* Decided before drawing any, as counters can share rows and
+	   drawing one flags those rows for the others */
+	for (int i = 0; i < set->count; i++)
+		intact[i] = opaque && counter_intact(ctx, &set->c[i]);
+
+	for (int i = 0; i < set->count; i++) {
+		struct kl_counter *c = &set->c[i];
+		char text[KL_COUNTER_MAX_CHARS + 1];
+		int changed = 0;
+
+		format_counter(c, ctx->pic_count, text);
+		if (strlen(text) != strlen(c->shown))
+			intact[i] = 0;
+
+		for (unsigned int n = 0; text[n]; n++) {
+			if (intact[i] && text[n] == c->shown[n])
+				continue;
+			kl_colorbar_render_ascii(ctx, text[n], c->x + n, c->y);
+			changed = 1;
+		}
+		if (changed)
+			kl_mark_rows(ctx, c->y * ctx->plotheight, ctx->plotheight,
+				     KL_ROW_DIRTY | (opaque ? KL_ROW_COUNTER : KL_ROW_OVERLAY));
+		memcpy(c->shown, text, sizeof(c->shown));
+	}
+
+	return 0;
+}
+
+int kl_colorbar_add_counter(struct kl_colorbar_context *ctx,
+			    enum kl_colorbar_counter type, unsigned int x,
+			    unsigned int y, unsigned int fps_num, unsigned int fps_den)
+{
+	struct kl_counters *set;
+	struct kl_counter *c;
+	unsigned int cell;
+
+	if (!ctx)
+		return -1;
+	if (type != KL_COLORBAR_COUNTER_FRAMES && type != KL_COLORBAR_COUNTER_TIMECODE)
+		return -1;
+	/* Frame numbers in the timecode are two digits */
+	if (type == KL_COLORBAR_COUNTER_TIMECODE &&
+	    (fps_den == 0 || fps_num < fps_den || fps_num / fps_den > 99))
+		return -1;
+
+	/* The whole field has to fit in the frame.  A timecode is 11
+	   cells wide, and the frame number at most 10. */
+	cell = ctx->plotwidth * (ctx->colorspace == KL_COLORBAR_10BIT ? 4 : 2);
+	if (((uint64_t)x + 11) * cell > kl_row_bytes(ctx) ||
+	    ((uint64_t)y + 1) * ctx->plotheight > ctx->height)
+		return -1;
+
+	set = ctx->counters;
+	if (set == NULL) {
+		set = calloc(1, sizeof(*set));
+		if (set == NULL)
+			return -1;
+		ctx->counters = set;
+	}
+	if (set->count == KL_MAX_COUNTERS)
+		return -1;
+
+	c = &set->c[set->count];
+	memset(c, 0, sizeof(*c));
+	c->type = type;
+	c->x = x;
+	c->y = y;
+	c->fps_num = fps_num;
+	c->fps_den = fps_den;
+
+	return set->count++;
+}
+
+int kl_colorbar_remove_counters(struct kl_colorbar_context *ctx)
+{
+	struct kl_counters *set;
+
+	if (!ctx)
+		return -1;
+
+	set = ctx->counters;
+	if (set == NULL)
+		return 0;
+
+	/* Hand the rows back to the next pattern fill to clean up */
+	for (int i = 0; i < set->count; i++) {
+		kl_clear_rows(ctx, set->c[i].y * ctx->plotheight, ctx->plotheight,
+			      KL_ROW_COUNTER);
+		kl_mark_rows(ctx, set->c[i].y * ctx->plotheight, ctx->plotheight,
+			     KL_ROW_OVERLAY);
+	}
+
+	free(set);
+	ctx->counters = NULL;
+	return 0;
+}
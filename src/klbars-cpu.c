@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Runtime selection of pixel kernels by instruction set.
+
+   The table is filled once, the first time a context is initialized,
+   from what the CPU reports.  Setting KLBARS_CPU_LEVEL in the
+   environment to one of "scalar", "sse2", "ssse3" or "avx2" caps the
+   level used, which is handy for A/B testing the SIMD kernels against
+   the scalar reference on the same host. */
+
+struct kl_kernels kl_kernels;
+
+static const char *level_names[] = {
+	[KL_COLORBAR_CPU_SCALAR] = "scalar",
+	[KL_COLORBAR_CPU_SSE2] = "sse2",
+	[KL_COLORBAR_CPU_SSSE3] = "ssse3",
+	[KL_COLORBAR_CPU_AVX2] = "avx2",
+};
+
+static const char *kernel_names[KL_KERNEL_MAX] = {
+	[KL_KERNEL_UYVY_TO_V210] = "finalize_uyvy_to_v210",
+	[KL_KERNEL_V210_TO_UYVY] = "finalize_v210_to_uyvy",
+	[KL_KERNEL_PACK_V210] = "compute_colorbar_10bit_array",
+	[KL_KERNEL_PACK_UYVY_LINE] = "pattern_pack_8bit",
+	[KL_KERNEL_PACK_V210_LINE] = "pattern_pack_10bit",
+	[KL_KERNEL_GLYPH_UYVY] = "render_character_8bit",
+	[KL_KERNEL_GLYPH_V210] = "render_character_10bit",
+	[KL_KERNEL_STREAM_COPY] = "replicate_large_rows",
+	[KL_KERNEL_BLEND_UYVY] = "text_blend_8bit",
+	[KL_KERNEL_BLEND_V210] = "text_blend_10bit",
+	[KL_KERNEL_UNPACK_UYVY] = "finalize_unpack_8bit",
+	[KL_KERNEL_UNPACK_V210] = "finalize_unpack_10bit",
+	[KL_KERNEL_LUMA_8] = "finalize_luma_8bit",
+	[KL_KERNEL_LUMA_16] = "finalize_luma_16bit",
+	[KL_KERNEL_CHROMA_NV12] = "finalize_chroma_nv12",
+	[KL_KERNEL_CHROMA_I420] = "finalize_chroma_i420",
+	[KL_KERNEL_CHROMA_P010] = "finalize_chroma_p010",
+	[KL_KERNEL_UYVY16] = "finalize_uyvy16",
+	[KL_KERNEL_RGB_BGRA] = "finalize_rgb_bgra",
+	[KL_KERNEL_RGB_R210] = "finalize_rgb_r210",
+	[KL_KERNEL_RGB_R12B] = "finalize_rgb_r12b",
+	[KL_KERNEL_TONE_S16] = "tone_pack_s16",
+	[KL_KERNEL_TONE_S32] = "tone_pack_s32",
+	[KL_KERNEL_TONE_F32] = "tone_pack_f32",
+	[KL_KERNEL_SINE_FILL] = "tone_sine",
+	[KL_KERNEL_LUMA_SUM_UYVY] = "avsync_luma_8bit",
+	[KL_KERNEL_LUMA_SUM_V210] = "avsync_luma_10bit",
+	[KL_KERNEL_COMP_SUM] = "verify_sum",
+};
+
+static enum kl_colorbar_cpu_level detected_level;
+static enum kl_colorbar_cpu_level current_level;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+static enum kl_colorbar_cpu_level detect_cpu_level(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return KL_COLORBAR_CPU_AVX2;
+	if (__builtin_cpu_supports("ssse3"))
+		return KL_COLORBAR_CPU_SSSE3;
+	if (__builtin_cpu_supports("sse2"))
+		return KL_COLORBAR_CPU_SSE2;
+#endif
+	return KL_COLORBAR_CPU_SCALAR;
+}
+
+#define KL_SELECT(id, field, fn, lvl) do { \
+	kl_kernels.field = fn; \
+	kl_kernels.impl[id] = lvl; \
+} while (0)
+
+static void select_kernels(enum kl_colorbar_cpu_level level)
+{
+	KL_SELECT(KL_KERNEL_UYVY_TO_V210, uyvy_to_v210_line, kl_uyvy_to_v210_line_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_V210_TO_UYVY, v210_to_uyvy_line, kl_v210_to_uyvy_line_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_PACK_V210, pack_v210_group, kl_pack_v210_group_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_PACK_UYVY_LINE, pack_uyvy_line, kl_pack_uyvy_line_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_PACK_V210_LINE, pack_v210_line, kl_pack_v210_line_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_GLYPH_UYVY, glyph_uyvy, kl_glyph_uyvy_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_GLYPH_V210, glyph_v210, kl_glyph_v210_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_STREAM_COPY, stream_copy, kl_stream_copy_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_BLEND_UYVY, blend_uyvy, kl_blend_uyvy_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_BLEND_V210, blend_v210, kl_blend_v210_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_UNPACK_UYVY, unpack_uyvy_line, kl_unpack_uyvy_line_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_UNPACK_V210, unpack_v210_line, kl_unpack_v210_line_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_LUMA_8, luma_8, kl_luma_8_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_LUMA_16, luma_16, kl_luma_16_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_CHROMA_NV12, chroma_nv12, kl_chroma_nv12_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_CHROMA_I420, chroma_i420, kl_chroma_i420_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_CHROMA_P010, chroma_p010, kl_chroma_p010_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_UYVY16, uyvy16_line, kl_uyvy16_line_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_RGB_BGRA, rgb_bgra, kl_rgb_bgra_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_RGB_R210, rgb_r210, kl_rgb_r210_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_RGB_R12B, rgb_r12b, kl_rgb_r12b_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_TONE_S16, tone_s16, kl_tone_s16_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_TONE_S32, tone_s32, kl_tone_s32_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_TONE_F32, tone_f32, kl_tone_f32_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_SINE_FILL, sine_fill, kl_sine_fill_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_LUMA_SUM_UYVY, luma_sum_uyvy, kl_luma_sum_uyvy_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_LUMA_SUM_V210, luma_sum_v210, kl_luma_sum_v210_c, KL_COLORBAR_CPU_SCALAR);
+	KL_SELECT(KL_KERNEL_COMP_SUM, comp_sum, kl_comp_sum_c, KL_COLORBAR_CPU_SCALAR);
+
+#if defined(__x86_64__) || defined(__i386__)
+	if (level >= KL_COLORBAR_CPU_SSE2) {
+		KL_SELECT(KL_KERNEL_PACK_V210, pack_v210_group, kl_pack_v210_group_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_PACK_UYVY_LINE, pack_uyvy_line, kl_pack_uyvy_line_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_GLYPH_UYVY, glyph_uyvy, kl_glyph_uyvy_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_GLYPH_V210, glyph_v210, kl_glyph_v210_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_STREAM_COPY, stream_copy, kl_stream_copy_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_BLEND_UYVY, blend_uyvy, kl_blend_uyvy_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_BLEND_V210, blend_v210, kl_blend_v210_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_UNPACK_UYVY, unpack_uyvy_line, kl_unpack_uyvy_line_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_LUMA_8, luma_8, kl_luma_8_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_LUMA_16, luma_16, kl_luma_16_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_CHROMA_NV12, chroma_nv12, kl_chroma_nv12_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_CHROMA_I420, chroma_i420, kl_chroma_i420_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_CHROMA_P010, chroma_p010, kl_chroma_p010_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_UYVY16, uyvy16_line, kl_uyvy16_line_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_RGB_BGRA, rgb_bgra, kl_rgb_bgra_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_RGB_R210, rgb_r210, kl_rgb_r210_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_RGB_R12B, rgb_r12b, kl_rgb_r12b_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_TONE_S16, tone_s16, kl_tone_s16_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_TONE_S32, tone_s32, kl_tone_s32_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_TONE_F32, tone_f32, kl_tone_f32_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_SINE_FILL, sine_fill, kl_sine_fill_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_LUMA_SUM_UYVY, luma_sum_uyvy, kl_luma_sum_uyvy_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_LUMA_SUM_V210, luma_sum_v210, kl_luma_sum_v210_sse2, KL_COLORBAR_CPU_SSE2);
+		KL_SELECT(KL_KERNEL_COMP_SUM, comp_sum, kl_comp_sum_sse2, KL_COLORBAR_CPU_SSE2);
+	}
+	if (level >= KL_COLORBAR_CPU_SSSE3) {
+		KL_SELECT(KL_KERNEL_UYVY_TO_V210, uyvy_to_v210_line, kl_uyvy_to_v210_line_ssse3, KL_COLORBAR_CPU_SSSE3);
+		KL_SELECT(KL_KERNEL_V210_TO_UYVY, v210_to_uyvy_line, kl_v210_to_uyvy_line_ssse3, KL_COLORBAR_CPU_SSSE3);
+		KL_SELECT(KL_KERNEL_PACK_V210_LINE, pack_v210_line, kl_pack_v210_line_ssse3, KL_COLORBAR_CPU_SSSE3);
+		KL_SELECT(KL_KERNEL_UNPACK_V210, unpack_v210_line, kl_unpack_v210_line_ssse3, KL_COLORBAR_CPU_SSSE3);
+	}
+	if (level >= KL_COLORBAR_CPU_AVX2) {
+		KL_SELECT(KL_KERNEL_UYVY_TO_V210, uyvy_to_v210_line, kl_uyvy_to_v210_line_avx2, KL_COLORBAR_CPU_AVX2);
+		KL_SELECT(KL_KERNEL_V210_TO_UYVY, v210_to_uyvy_line, kl_v210_to_uyvy_line_avx2, KL_COLORBAR_CPU_AVX2);
+	}
+#endif
+
+	current_level = level;
+}
+
+static void kernels_init_once(void)
+{
+	enum kl_colorbar_cpu_level level;
+	const char *force;
+
+	detected_level = detect_cpu_level();
+	level = detected_level;
+
+	force = getenv("KLBARS_CPU_LEVEL");
+	if (force) {
+		for (int i = 0; i <= KL_COLORBAR_CPU_AVX2; i++) {
+			if (strcasecmp(force, level_names[i]) == 0 && i < level)
+				level = i;
+		}
+	}
+
+	select_kernels(level);
+}
+
+void kl_kernels_init(void)
+{
+	pthread_once(&kernels_once, kernels_init_once);
+}
+
+int kl_colorbar_set_cpu_level(enum kl_colorbar_cpu_level level)
+{
+	kl_kernels_init();
+
+	if (level < KL_COLORBAR_CPU_SCALAR || level > detected_level)
+		return -1;
+
+	select_kernels(level);
+	return 0;
+}
+
+enum kl_colorbar_cpu_level kl_colorbar_get_cpu_level(void)
+{
+	kl_kernels_init();
+	return current_level;
+}
+
+const char *kl_colorbar_get_kernel_name(int kernel)
+{
+	if (kernel < 0 || kernel >= KL_KERNEL_MAX)
+		return NULL;
+
+	return kernel_names[kernel];
+}
+
+const char *kl_colorbar_get_kernel_impl(int kernel)
+{
+	if (kernel < 0 || kernel >= KL_KERNEL_MAX)
+		return NULL;
+
+	kl_kernels_init();
+	return level_names[kl_kernels.impl[kernel]];
+}
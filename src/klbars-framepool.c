@@ -0,0 +1,349 @@
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Frames rendered ahead of time by a background thread.
+
+   Every frame is always in exactly one place: the free ring, the
+   producer, the ready ring or the caller.  Both rings are bounded
+   lock-free queues (Vyukov's, one sequence number per slot), so taking
+   a frame and handing it back never blocks, whichever thread does it.
+   Only the producer ever waits, on a semaphore counting free frames,
+   and posting that doesn't block either.
+
+   Between start and stop the producer thread owns the context, so
+   everything per frame has to happen in the render callback. */
+
+#define KL_FRAME_POOL_MAX 64
+
+/* Pause after a frame failed to render, rather than spin on it */
+#define KL_FRAME_POOL_RETRY_NS 1000000
+
+struct kl_frame_slot {
+	atomic_uint seq;
+	struct kl_colorbar_frame *frame;
+};
+
+struct kl_frame_ring {
+	struct kl_frame_slot slots[KL_FRAME_POOL_MAX];
+	unsigned int mask;
+	/* Apart, so pushing and popping threads don't share a line */
+	_Alignas(64) atomic_uint head;
+	_Alignas(64) atomic_uint tail;
+};
+
+struct kl_frame_pool {
+	struct kl_colorbar_context *ctx;
+	enum kl_colorbar_pattern pattern;
+	kl_colorbar_frame_fn render;
+	void *priv;
+
+	struct kl_colorbar_frame frames[KL_FRAME_POOL_MAX];
+	unsigned int count;
+	unsigned char *data;
+
+	struct kl_frame_ring free_ring;
+	struct kl_frame_ring ready_ring;
+	sem_t free_sem;
+	pthread_t thread;
+	atomic_int quit;
+
+	atomic_uint depth;
+	atomic_ullong rendered;
+	atomic_ullong delivered;
+	atomic_ullong underruns;
+	atomic_ullong errors;
+};
+
+static void ring_init(struct kl_frame_ring *ring, unsigned int count)
+{
+	unsigned int size = 1;
+
+	while (size < count)
+		size <<= 1;
+	ring->mask = size - 1;
+	for (unsigned int i = 0; i < size; i++)
+		atomic_init(&ring->slots[i].seq, i);
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+}
+
+static int ring_push(struct kl_frame_ring *ring, struct kl_colorbar_frame *frame)
+{
+	unsigned int pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	struct kl_frame_slot *slot;
+
+	while (1) {
+		int diff;
+
+		slot = &ring->slots[pos & ring->mask];
+		diff = (int)(atomic_load_explicit(&slot->seq, memory_order_acquire) - pos);
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1,
+								  memory_order_relaxed,
+								  memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			return -1;
+		} else {
+			pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+		}
+	}
+
+	slot->frame = frame;
+	atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+	return 0;
+}
+
+static struct kl_colorbar_frame *ring_pop(struct kl_frame_ring *ring)
+{
+	unsigned int pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	struct kl_colorbar_frame *frame;
+	struct kl_frame_slot *slot;
+
+	while (1) {
+		int diff;
+
+		slot = &ring->slots[pos & ring->mask];
+		diff = (int)(atomic_load_explicit(&slot->seq, memory_order_acquire) - (pos + 1));
+		if (diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&ring->tail, &pos, pos + 1,
+								  memory_order_relaxed,
+								  memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			return NULL;
+		} else {
+			pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		}
+	}
+
+	frame = slot->frame;
+	atomic_store_explicit(&slot->seq, pos + ring->mask + 1, memory_order_release);
+	return frame;
+}
+
+/* Never handed out, so it goes back to be rendered again */
+static void frame_failed(struct kl_frame_pool *pool, struct kl_colorbar_frame *frame)
+{
+	const struct timespec pause = { 0, KL_FRAME_POOL_RETRY_NS };
+
+	atomic_fetch_add_explicit(&pool->errors, 1, memory_order_relaxed);
+	ring_push(&pool->free_ring, frame);
+	sem_post(&pool->free_sem);
+	nanosleep(&pause, NULL);
+}
+
+static void *producer_thread(void *p)
+{
+	struct kl_frame_pool *pool = p;
+	struct kl_colorbar_context *ctx = pool->ctx;
+
+	while (1) {
+		struct kl_colorbar_frame *frame;
+
+		if (sem_wait(&pool->free_sem) < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		if (atomic_load(&pool->quit))
+			break;
+
+		/* The token is posted after the push, but a put racing
+		   another can still be finishing it, so the frame is on its
+		   way.  Dropping the token would lose the frame for good. */
+		while ((frame = ring_pop(&pool->free_ring)) == NULL)
+			sched_yield();
+
+		if (kl_colorbar_fill_pattern(ctx, pool->pattern) < 0) {
+			frame_failed(pool, frame);
+			continue;
+		}
+		if (pool->render)
+			pool->render(ctx, pool->priv);
+		frame->pic_count = ctx->pic_count;
+		if (kl_colorbar_finalize_planes(ctx, &frame->planes) < 0) {
+			frame_failed(pool, frame);
+			continue;
+		}
+
+		/* Counted first, so depth never goes below zero */
+		atomic_fetch_add(&pool->rendered, 1);
+		atomic_fetch_add(&pool->depth, 1);
+		ring_push(&pool->ready_ring, frame);
+	}
+
+	return NULL;
+}
+
+void kl_frame_pool_free(struct kl_colorbar_context *ctx)
+{
+	struct kl_frame_pool *pool = ctx->frame_pool;
+
+	if (pool == NULL)
+		return;
+
+	atomic_store(&pool->quit, 1);
+	sem_post(&pool->free_sem);
+	pthread_join(pool->thread, NULL);
+
+	sem_destroy(&pool->free_sem);
+	free(pool->data);
+	free(pool);
+	ctx->frame_pool = NULL;
+}
+
+size_t kl_frame_layout(const struct kl_colorbar_context *ctx, enum kl_colorbar_format format,
+		       struct kl_colorbar_frame *frame, unsigned char *data)
+{
+	unsigned int row_bytes[KL_COLORBAR_MAX_PLANES];
+	size_t bytes = 0;
+	int planes, vsub;
+
+	planes = kl_format_layout(ctx, format, row_bytes, &vsub);
+	if (planes < 0)
+		return 0;
+
+	if (frame)
+		memset(frame, 0, sizeof(*frame));
+	for (int i = 0; i < planes; i++) {
+		unsigned int rows = i == 0 ? ctx->height : (ctx->height + vsub - 1) / vsub;
+
+		if (frame) {
+			frame->planes.format = format;
+			frame->planes.data[i] = data + bytes;
+			frame->planes.stride[i] = row_bytes[i];
+		}
+		bytes += (size_t)row_bytes[i] * rows;
+	}
+	return bytes;
+}
+
+int kl_colorbar_frame_pool_start(struct kl_colorbar_context *ctx, unsigned int frames,
+				 enum kl_colorbar_format format,
+				 enum kl_colorbar_pattern pattern,
+				 kl_colorbar_frame_fn render, void *priv)
+{
+	struct kl_frame_pool *pool;
+	size_t frame_bytes;
+
+	if ((!ctx) || ctx->frame_pool || frames < 1 || frames > KL_FRAME_POOL_MAX)
+		return -1;
+	if (kl_pattern_find(ctx, pattern) == NULL)
+		return -1;
+
+	frame_bytes = kl_frame_layout(ctx, format, NULL, NULL);
+	if (frame_bytes == 0)
+		return -1;
+
+	/* Aligned for the ring indices */
+	if (posix_memalign((void **)&pool, 64, sizeof(*pool)) != 0)
+		return -1;
+	memset(pool, 0, sizeof(*pool));
+	pool->data = calloc(frames, frame_bytes);
+	if (pool->data == NULL || sem_init(&pool->free_sem, 0, 0) < 0) {
+		free(pool->data);
+		free(pool);
+		return -1;
+	}
+
+	pool->ctx = ctx;
+	pool->pattern = pattern;
+	pool->render = render;
+	pool->priv = priv;
+	pool->count = frames;
+	ring_init(&pool->free_ring, frames);
+	ring_init(&pool->ready_ring, frames);
+
+	/* Every frame starts out free */
+	for (unsigned int f = 0; f < frames; f++) {
+		struct kl_colorbar_frame *frame = &pool->frames[f];
+
+		kl_frame_layout(ctx, format, frame, pool->data + frame_bytes * f);
+		ring_push(&pool->free_ring, frame);
+		sem_post(&pool->free_sem);
+	}
+
+	if (pthread_create(&pool->thread, NULL, producer_thread, pool) != 0) {
+		sem_destroy(&pool->free_sem);
+		free(pool->data);
+		free(pool);
+		return -1;
+	}
+
+	ctx->frame_pool = pool;
+	return 0;
+}
+
+struct kl_colorbar_frame *kl_colorbar_frame_pool_get(struct kl_colorbar_context *ctx)
+{
+	struct kl_frame_pool *pool;
+	struct kl_colorbar_frame *frame;
+
+	if ((!ctx) || (!ctx->frame_pool))
+		return NULL;
+
+	pool = ctx->frame_pool;
+	frame = ring_pop(&pool->ready_ring);
+	if (frame == NULL) {
+		atomic_fetch_add_explicit(&pool->underruns, 1, memory_order_relaxed);
+		return NULL;
+	}
+
+	atomic_fetch_sub_explicit(&pool->depth, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&pool->delivered, 1, memory_order_relaxed);
+	return frame;
+}
+
+int kl_colorbar_frame_pool_put(struct kl_colorbar_context *ctx, struct kl_colorbar_frame *frame)
+{
+	struct kl_frame_pool *pool;
+
+	if ((!ctx) || (!ctx->frame_pool) || (!frame))
+		return -1;
+
+	pool = ctx->frame_pool;
+	if (frame < pool->frames || frame >= pool->frames + pool->count)
+		return -1;
+
+	if (ring_push(&pool->free_ring, frame) < 0)
+		return -1;
+	sem_post(&pool->free_sem);
+	return 0;
+}
+
+int kl_colorbar_frame_pool_get_stats(struct kl_colorbar_context *ctx,
+				     struct kl_colorbar_frame_pool_stats *stats)
+{
+	struct kl_frame_pool *pool;
+
+	if ((!ctx) || (!ctx->frame_pool) || (!stats))
+		return -1;
+
+	pool = ctx->frame_pool;
+	stats->frames = pool->count;
+	stats->depth = atomic_load_explicit(&pool->depth, memory_order_relaxed);
+	stats->rendered = atomic_load_explicit(&pool->rendered, memory_order_relaxed);
+	stats->delivered = atomic_load_explicit(&pool->delivered, memory_order_relaxed);
+	stats->underruns = atomic_load_explicit(&pool->underruns, memory_order_relaxed);
+	stats->errors = atomic_load_explicit(&pool->errors, memory_order_relaxed);
+	return 0;
+}
+
+int kl_colorbar_frame_pool_stop(struct kl_colorbar_context *ctx)
+{
+	if (!ctx)
+		return -1;
+
+	kl_frame_pool_free(ctx);
+	return 0;
+}
@@ -0,0 +1,134 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Multichannel tones, each channel with its own frequency, level and
+   interruptions.
+
+   A channel repeats every lcm(rate / gcd(freq, rate), cycle) samples,
+   and the tone holds the lcm of that over all the channels.  Each
+   channel's sine is computed for one period only, then laid out over
+   the loop with its on/off envelope, and converted into its place. */
+
+/* Longest loop that will be kept, in seconds */
+#define KL_MULTI_MAX_SECONDS 60
+
+static uint64_t lcm64(uint64_t a, uint64_t b)
+{
+	return a / kl_gcd64(a, b) * b;
+}
+
+/* Samples in a channel's on/off cycle, or 0 for a continuous tone */
+static uint64_t cycle_samples(const struct kl_colorbar_tone_spec *spec, int sampleRate)
+{
+	return (uint64_t)spec->cycle_ms * sampleRate / 1000;
+}
+
+static int render_channel(const struct kl_colorbar_tone_spec *spec, int sampleRate,
+			  float *wave, float *period_buf, size_t samples)
+{
+	const int64_t freq = ((int64_t)spec->freq_hz % sampleRate + sampleRate) % sampleRate;
+	const int64_t period = sampleRate / kl_gcd64(freq, sampleRate);
+	const float level = spec->freq_hz ? pow(10.0, spec->level_dbfs / 20) : 0;
+	const uint64_t cycle = cycle_samples(spec, sampleRate);
+	const uint64_t mute_start = (uint64_t)spec->mute_start_ms * sampleRate / 1000;
+	const uint64_t mute_end = mute_start + (uint64_t)spec->mute_ms * sampleRate / 1000;
+	int64_t p = 0;
+	uint64_t c = 0;
+
+	if (kl_tone_sine(period_buf, period, freq, sampleRate, 0, level) < 0)
+		return -1;
+
+	for (size_t i = 0; i < samples; i++) {
+		wave[i] = (cycle && c >= mute_start && c < mute_end) ? 0 : period_buf[p];
+		if (++p == period)
+			p = 0;
+		if (++c == cycle)
+			c = 0;
+	}
+	return 0;
+}
+
+int kl_colorbar_tonegenerator_multi(struct kl_colorbar_audio_context *audio_ctx,
+				    const struct kl_colorbar_tone_spec *specs, int channelCount,
+				    enum kl_colorbar_sample_format format, unsigned int flags,
+				    int sampleRate)
+{
+	uint64_t loop = 1, longest = 1;
+	float *wave, *period_buf;
+	int ret = 0;
+
+	if ((!audio_ctx) || (!specs) || sampleRate <= 0 || channelCount <= 0 ||
+	    channelCount > KL_COLORBAR_TONE_MAX_CHANNELS)
+		return -1;
+
+	for (int c = 0; c < channelCount; c++) {
+		int64_t freq = ((int64_t)specs[c].freq_hz % sampleRate + sampleRate) % sampleRate;
+		uint64_t period = sampleRate / kl_gcd64(freq, sampleRate);
+		uint64_t cycle = cycle_samples(&specs[c], sampleRate);
+
+		if ((uint64_t)specs[c].cycle_ms * sampleRate % 1000 != 0)
+			return -1;
+		/* Past full scale would clip, and NaN is no level at all */
+		if (!(specs[c].level_dbfs <= 0))
+			return -1;
+		if (period > longest)
+			longest = period;
+		loop = lcm64(loop, period);
+		if (cycle)
+			loop = lcm64(loop, cycle);
+		if (loop > (uint64_t)KL_MULTI_MAX_SECONDS * sampleRate)
+			return -1;
+	}
+	loop = kl_tone_loop_samples(loop, sampleRate);
+
+	if (kl_tone_alloc(audio_ctx, format, flags, channelCount, loop) < 0)
+		return -1;
+
+	wave = malloc(loop * sizeof(float));
+	period_buf = malloc(longest * sizeof(float));
+	for (int c = 0; wave && period_buf && c < channelCount && ret == 0; c++) {
+		ret = render_channel(&specs[c], sampleRate, wave, period_buf, loop);
+		if (ret == 0)
+			ret = kl_tone_set_channels(audio_ctx, c, 1, wave);
+	}
+	if (wave == NULL || period_buf == NULL || ret < 0) {
+		kl_colorbar_tonegenerator_free(audio_ctx);
+		ret = -1;
+	}
+	free(wave);
+	free(period_buf);
+	return ret;
+}
+
+int kl_colorbar_tone_specs_ident(struct kl_colorbar_tone_spec *specs, int channelCount)
+{
+	if ((!specs) || channelCount <= 0 || channelCount > KL_COLORBAR_TONE_MAX_CHANNELS)
+		return -1;
+
+	memset(specs, 0, sizeof(*specs) * channelCount);
+	for (int c = 0; c < channelCount; c++) {
+		specs[c].freq_hz = 400 + 100 * c;
+		specs[c].level_dbfs = -18;
+	}
+	return 0;
+}
+
+int kl_colorbar_tone_specs_ebu3304(struct kl_colorbar_tone_spec *specs, int channelCount)
+{
+	if ((!specs) || channelCount <= 0 || channelCount > KL_COLORBAR_TONE_MAX_CHANNELS)
+		return -1;
+
+	memset(specs, 0, sizeof(*specs) * channelCount);
+	for (int c = 0; c < channelCount; c++) {
+		specs[c].freq_hz = 1000;
+		specs[c].level_dbfs = -18;
+		specs[c].cycle_ms = channelCount * 250 + 500;
+		specs[c].mute_start_ms = c * 250;
+		specs[c].mute_ms = 250;
+	}
+	return 0;
+}
@@ -1,12 +1,413 @@
+#ifndef klbars_internal_h
+#define klbars_internal_h
+
+#include <stddef.h>
 #include <stdint.h>
 
-void compute_colorbar_10bit_array(const uint32_t uyvy, uint8_t *bar10);
+/* Bytes actually used by one row of the frame */
+static inline unsigned int kl_row_bytes(const struct kl_colorbar_context *ctx)
+{
+	if (ctx->colorspace == KL_COLORBAR_10BIT) {
+		/* V210 stride required by Blackmagic Decklink */
+		return ((ctx->width + 47) / 48) * 128;
+	}
+	return ctx->width * 2;
+}
 
-void compute_colorbar_10bit_array2(uint16_t y0, uint16_t cb, uint16_t cr,
-				   uint8_t *bar10);
+/* Frames wider than SD use the BT.709 colours and matrix, as for EIA-189A */
+static inline int kl_is_hd(const struct kl_colorbar_context *ctx)
+{
+	return ctx->width > 720;
+}
+
+static inline uint64_t kl_gcd64(uint64_t a, uint64_t b)
+{
+	while (b) {
+		uint64_t t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+void compute_colorbar_10bit_array(const uint32_t uyvy, uint8_t *bar10);
 
 int kl_colorbar_render_moveto(struct kl_colorbar_context *ctx, int x, int y);
+int kl_colorbar_render_ascii(struct kl_colorbar_context *ctx, uint8_t letter, int x, int y);
+void kl_glyph_cache_free(struct kl_colorbar_context *ctx);
+
+/* Text background opacity is kept in 64ths, which keeps the blend of a
+   10-bit component within 16 bits */
+#define KL_TEXT_OPAQUE 64
+
+/* Frame number and timecode overlays, see klbars-counter.c */
+int kl_counters_draw(struct kl_colorbar_context *ctx);
+
+/* Declarative pattern descriptions, see klbars-pattern.c.
+
+   A pattern is a stack of horizontal bands, and each band is a run of
+   spans across the frame.  Sizes are fractions of the frame width or
+   height, and colours are 10-bit Y/Cb/Cr.  A span ramps from its left
+   edge colour to its right edge colour, so a solid span has both the
+   same.  The lists end at the first zero sized entry, and the last
+   band and span always extend to the edge of the frame. */
+struct kl_span {
+	double width;
+	uint16_t y0, cb0, cr0;
+	uint16_t y1, cb1, cr1;
+};
+
+#define KL_SOLID(w, y, cb, cr) { (w), (y), (cb), (cr), (y), (cb), (cr) }
+#define KL_RAMP(w, y0, cb0, cr0, y1, cb1, cr1) \
+	{ (w), (y0), (cb0), (cr0), (y1), (cb1), (cr1) }
+
+#define KL_MAX_SPANS 16
+#define KL_MAX_BANDS 8
+
+struct kl_pattern_band {
+	double height;
+	struct kl_span spans[KL_MAX_SPANS];
+};
+
+struct kl_pattern_desc {
+	char name[64];
+	struct kl_pattern_band bands[KL_MAX_BANDS];
+};
+
+extern const struct kl_pattern_desc kl_pattern_black;
+extern const struct kl_pattern_desc kl_pattern_white;
+extern const struct kl_pattern_desc kl_pattern_eia189_sd;
+extern const struct kl_pattern_desc kl_pattern_eia189_hd;
+extern const struct kl_pattern_desc kl_pattern_rp219_1;
+extern const struct kl_pattern_desc kl_pattern_rp198;
+
+const struct kl_pattern_desc *kl_pattern_find(const struct kl_colorbar_context *ctx,
+					      int pattern);
+int kl_pattern_register(struct kl_pattern_desc *desc);
+int kl_pattern_raster(struct kl_colorbar_context *ctx,
+		      const struct kl_pattern_band *band, uint32_t row_num);
+
+/* The geometry kl_pattern_raster() draws with, for a row of pixels
+   columns (width rounded up to a whole packing group).  Span s covers
+   columns [edges[s], edges[s + 1]), and the number of spans is
+   returned.  kl_pattern_components() draws the row as 10-bit
+   components in UYVY order, pixels * 2 of them. */
+int kl_pattern_span_edges(const struct kl_pattern_band *band, uint32_t width,
+			  uint32_t pixels, uint32_t *edges);
+void kl_pattern_components(const struct kl_pattern_band *band, uint32_t width,
+			   uint32_t pixels, uint16_t *comp);
+
+/* A run of identical rows [first, end), all rasterized from desc */
+struct kl_band {
+	uint32_t first;
+	uint32_t end;
+	const struct kl_pattern_band *desc;
+};
 
 void kl_colorbar_fill_rp219_1(struct kl_colorbar_context *ctx);
 
 void kl_colorbar_fill_rp198(struct kl_colorbar_context *ctx);
+
+void kl_colorbar_rp198_polarity(struct kl_colorbar_context *ctx);
+
+int kl_pattern_bands(struct kl_colorbar_context *ctx, int pattern,
+		     struct kl_band *bands);
+
+int kl_fill_bands(struct kl_colorbar_context *ctx, const struct kl_band *bands,
+		  int count);
+int kl_restore_bands(struct kl_colorbar_context *ctx, const struct kl_band *bands,
+		     int count);
+
+/* Per row state in ctx->rowflags, only kept with dirty tracking on */
+#define KL_ROW_DIRTY   0x01 /* Changed since the last finalize */
+#define KL_ROW_OVERLAY 0x02 /* Drawn over since the last pattern fill */
+#define KL_ROW_COUNTER 0x04 /* Holds a counter, which pattern fills keep */
+
+void kl_mark_rows(struct kl_colorbar_context *ctx, uint32_t first,
+		  uint32_t count, unsigned char flags);
+void kl_clear_rows(struct kl_colorbar_context *ctx, uint32_t first,
+		   uint32_t count, unsigned char flags);
+
+/* Shared pattern cache, see klbars-cache.c */
+int kl_cache_fill(struct kl_colorbar_context *ctx, int pattern);
+int kl_cache_make_private(struct kl_colorbar_context *ctx);
+void kl_cache_detach(struct kl_colorbar_context *ctx);
+
+/* Worker pool, see klbars-workers.c.  Runs fn over rows [0, rows)
+   split into bands, on the context's worker threads when it has
+   them. */
+typedef void (*kl_worker_fn)(void *arg, uint32_t first, uint32_t end);
+
+void kl_workers_run(struct kl_colorbar_context *ctx, kl_worker_fn fn, void *arg,
+		    uint32_t rows, uint32_t rowBytes);
+void kl_workers_free(struct kl_colorbar_context *ctx);
+
+/* Stops the producer and frees every frame, see klbars-framepool.c */
+void kl_frame_pool_free(struct kl_colorbar_context *ctx);
+
+/* Bytes in a frame of the format, or 0 if there is no such format.
+   With a frame, also points its planes into data. */
+size_t kl_frame_layout(const struct kl_colorbar_context *ctx, enum kl_colorbar_format format,
+		       struct kl_colorbar_frame *frame, unsigned char *data);
+
+/* Single line format converters, used by kl_colorbar_finalize() */
+typedef void (*kl_line_convert_fn)(const uint8_t *line, uint8_t *buf,
+				   unsigned int width);
+
+void kl_uyvy_to_v210_line_c(const uint8_t *line, uint8_t *buf, unsigned int width);
+void kl_v210_to_uyvy_line_c(const uint8_t *line, uint8_t *buf, unsigned int width);
+#if defined(__x86_64__) || defined(__i386__)
+void kl_uyvy_to_v210_line_ssse3(const uint8_t *line, uint8_t *buf, unsigned int width);
+void kl_uyvy_to_v210_line_avx2(const uint8_t *line, uint8_t *buf, unsigned int width);
+void kl_v210_to_uyvy_line_ssse3(const uint8_t *line, uint8_t *buf, unsigned int width);
+void kl_v210_to_uyvy_line_avx2(const uint8_t *line, uint8_t *buf, unsigned int width);
+#endif
+
+/* Line kernels for kl_colorbar_finalize_planes(), see klbars-planar.c */
+typedef void (*kl_unpack_fn)(const uint8_t *line, uint16_t *comp, unsigned int count);
+typedef void (*kl_plane_line_fn)(const uint16_t *comp, void *dst, unsigned int count);
+typedef void (*kl_chroma_fn)(const uint16_t *c0, const uint16_t *c1, void *dst0,
+			     void *dst1, unsigned int pairs);
+
+void kl_unpack_uyvy_line_c(const uint8_t *line, uint16_t *comp, unsigned int count);
+void kl_unpack_v210_line_c(const uint8_t *line, uint16_t *comp, unsigned int count);
+void kl_luma_8_c(const uint16_t *comp, void *dst, unsigned int pixels);
+void kl_luma_16_c(const uint16_t *comp, void *dst, unsigned int pixels);
+void kl_chroma_nv12_c(const uint16_t *c0, const uint16_t *c1, void *dst0,
+		      void *dst1, unsigned int pairs);
+void kl_chroma_i420_c(const uint16_t *c0, const uint16_t *c1, void *dst0,
+		      void *dst1, unsigned int pairs);
+void kl_chroma_p010_c(const uint16_t *c0, const uint16_t *c1, void *dst0,
+		      void *dst1, unsigned int pairs);
+void kl_uyvy16_line_c(const uint16_t *comp, void *dst, unsigned int count);
+#if defined(__x86_64__) || defined(__i386__)
+void kl_unpack_uyvy_line_sse2(const uint8_t *line, uint16_t *comp, unsigned int count);
+void kl_unpack_v210_line_ssse3(const uint8_t *line, uint16_t *comp, unsigned int count);
+void kl_luma_8_sse2(const uint16_t *comp, void *dst, unsigned int pixels);
+void kl_luma_16_sse2(const uint16_t *comp, void *dst, unsigned int pixels);
+void kl_chroma_nv12_sse2(const uint16_t *c0, const uint16_t *c1, void *dst0,
+			 void *dst1, unsigned int pairs);
+void kl_chroma_i420_sse2(const uint16_t *c0, const uint16_t *c1, void *dst0,
+			 void *dst1, unsigned int pairs);
+void kl_chroma_p010_sse2(const uint16_t *c0, const uint16_t *c1, void *dst0,
+			 void *dst1, unsigned int pairs);
+void kl_uyvy16_line_sse2(const uint16_t *comp, void *dst, unsigned int count);
+#endif
+
+/* Bytes per row of each plane of an output format, and the lines per
+   row of the planes after the first.  Returns the number of planes. */
+int kl_format_layout(const struct kl_colorbar_context *ctx, enum kl_colorbar_format format,
+		     unsigned int *row_bytes, int *vsub);
+
+/* Fixed point Y'CbCr to RGB matrix for one output depth, see klbars-rgb.c */
+struct kl_rgb_matrix {
+	int16_t cy, crv, cgu, cgv, cbu;
+	int32_t bias;
+	int shift;
+	int max;
+};
+
+void kl_rgb_matrix_init(struct kl_rgb_matrix *m, int hd, int bits, int video_levels);
+
+typedef void (*kl_rgb_fn)(const uint16_t *comp, void *dst, unsigned int pixels,
+			  const struct kl_rgb_matrix *m);
+
+void kl_rgb_bgra_c(const uint16_t *comp, void *dst, unsigned int pixels,
+		   const struct kl_rgb_matrix *m);
+void kl_rgb_r210_c(const uint16_t *comp, void *dst, unsigned int pixels,
+		   const struct kl_rgb_matrix *m);
+void kl_rgb_r12b_c(const uint16_t *comp, void *dst, unsigned int pixels,
+		   const struct kl_rgb_matrix *m);
+#if defined(__x86_64__) || defined(__i386__)
+void kl_rgb_bgra_sse2(const uint16_t *comp, void *dst, unsigned int pixels,
+		      const struct kl_rgb_matrix *m);
+void kl_rgb_r210_sse2(const uint16_t *comp, void *dst, unsigned int pixels,
+		      const struct kl_rgb_matrix *m);
+void kl_rgb_r12b_sse2(const uint16_t *comp, void *dst, unsigned int pixels,
+		      const struct kl_rgb_matrix *m);
+#endif
+
+/* Tone sample conversion, see klbars-audio.c */
+typedef void (*kl_tone_pack_fn)(const float *in, void *out, unsigned int count, float scale,
+				int swap);
+
+void kl_tone_s16_c(const float *in, void *out, unsigned int count, float scale, int swap);
+void kl_tone_s32_c(const float *in, void *out, unsigned int count, float scale, int swap);
+void kl_tone_f32_c(const float *in, void *out, unsigned int count, float scale, int swap);
+#if defined(__x86_64__) || defined(__i386__)
+void kl_tone_s16_sse2(const float *in, void *out, unsigned int count, float scale, int swap);
+void kl_tone_s32_sse2(const float *in, void *out, unsigned int count, float scale, int swap);
+void kl_tone_f32_sse2(const float *in, void *out, unsigned int count, float scale, int swap);
+#endif
+
+/* Sine synthesis, see klbars-audio.c.  out[i] is level * sin(2 pi x / modulus)
+   for x = (phase + i * step) % modulus, with modulus a multiple of four no
+   bigger than 2^30 and phase, step below it. */
+typedef void (*kl_sine_fill_fn)(float *out, unsigned int count, uint32_t step,
+				uint32_t modulus, uint32_t phase, float level);
+
+void kl_sine_fill_c(float *out, unsigned int count, uint32_t step, uint32_t modulus,
+		    uint32_t phase, float level);
+#if defined(__x86_64__) || defined(__i386__)
+void kl_sine_fill_sse2(float *out, unsigned int count, uint32_t step, uint32_t modulus,
+		       uint32_t phase, float level);
+#endif
+
+/* Tone buffers, see klbars-tone.c.  kl_tone_alloc() sets up a zeroed
+   tone of samples per channel, and kl_tone_set_channels() converts one
+   channel's worth of floats into channels [first, first + count).
+   kl_tone_sine() synthesizes samples of a tone at the given level,
+   starting quarters quarter cycles in (so 1 makes a cosine), for rates
+   up to KL_TONE_MAX_RATE.  kl_tone_loop_samples() repeats a period
+   until the loop holds a frame of audio at KL_TONE_MIN_FPS. */
+#define KL_TONE_MIN_SAMPLES 4096
+#define KL_TONE_MIN_FPS 10
+#define KL_TONE_MAX_RATE (1 << 24)
+
+uint64_t kl_tone_loop_samples(uint64_t period, int sampleRate);
+int kl_tone_alloc(struct kl_colorbar_audio_context *audio_ctx,
+		  enum kl_colorbar_sample_format format, unsigned int flags,
+		  int channelCount, size_t samples);
+int kl_tone_set_channels(struct kl_colorbar_audio_context *audio_ctx, unsigned int first,
+			 unsigned int count, const float *wave);
+int kl_tone_sine(float *wave, size_t samples, int64_t freq, int sampleRate,
+		 unsigned int quarters, float level);
+
+/* Luma sums of a line for the A/V sync analyzer, see klbars-avsync.c */
+typedef uint64_t (*kl_luma_sum_fn)(const uint8_t *line, unsigned int pixels);
+
+uint64_t kl_luma_sum_uyvy_c(const uint8_t *line, unsigned int pixels);
+uint64_t kl_luma_sum_v210_c(const uint8_t *line, unsigned int pixels);
+#if defined(__x86_64__) || defined(__i386__)
+uint64_t kl_luma_sum_uyvy_sse2(const uint8_t *line, unsigned int pixels);
+uint64_t kl_luma_sum_v210_sse2(const uint8_t *line, unsigned int pixels);
+#endif
+
+/* Component sums for the pattern verifier, see klbars-verify.c.  Adds
+   the Cb, Y and Cr of pairs of pixels of 10-bit components to sums. */
+typedef void (*kl_comp_sum_fn)(const uint16_t *comp, unsigned int pairs, uint32_t *sums);
+
+void kl_comp_sum_c(const uint16_t *comp, unsigned int pairs, uint32_t *sums);
+#if defined(__x86_64__) || defined(__i386__)
+void kl_comp_sum_sse2(const uint16_t *comp, unsigned int pairs, uint32_t *sums);
+#endif
+
+/* Pattern line packing and glyph kernels used when drawing into the frame */
+void kl_pack_v210_group_c(uint16_t y0, uint16_t cb, uint16_t cr, uint8_t *bar10);
+void kl_pack_uyvy_line_c(const uint16_t *comp, uint8_t *dst, unsigned int count);
+void kl_pack_v210_line_c(const uint16_t *comp, uint8_t *dst, unsigned int count);
+void kl_glyph_uyvy_c(uint8_t *dst, unsigned int stride, uint8_t letter,
+		     int plotctrl, int repeat, const uint8_t *fg, const uint8_t *bg);
+void kl_glyph_v210_c(uint8_t *dst, unsigned int stride, uint8_t letter,
+		     int plotctrl, int repeat, const uint8_t *bar10_fg,
+		     const uint8_t *bar10_bg);
+typedef void (*kl_blend_fn)(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+			    unsigned int bytes, unsigned int alpha);
+void kl_blend_uyvy_c(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+		     unsigned int bytes, unsigned int alpha);
+void kl_blend_v210_c(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+		     unsigned int bytes, unsigned int alpha);
+typedef void (*kl_row_copy_fn)(uint8_t *dst, const uint8_t *src, unsigned int bytes);
+void kl_stream_copy_c(uint8_t *dst, const uint8_t *src, unsigned int bytes);
+#if defined(__x86_64__) || defined(__i386__)
+void kl_pack_v210_group_sse2(uint16_t y0, uint16_t cb, uint16_t cr, uint8_t *bar10);
+void kl_pack_uyvy_line_sse2(const uint16_t *comp, uint8_t *dst, unsigned int count);
+void kl_pack_v210_line_ssse3(const uint16_t *comp, uint8_t *dst, unsigned int count);
+void kl_glyph_uyvy_sse2(uint8_t *dst, unsigned int stride, uint8_t letter,
+			int plotctrl, int repeat, const uint8_t *fg, const uint8_t *bg);
+void kl_glyph_v210_sse2(uint8_t *dst, unsigned int stride, uint8_t letter,
+			int plotctrl, int repeat, const uint8_t *bar10_fg,
+			const uint8_t *bar10_bg);
+void kl_blend_uyvy_sse2(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+			unsigned int bytes, unsigned int alpha);
+void kl_blend_v210_sse2(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+			unsigned int bytes, unsigned int alpha);
+void kl_stream_copy_sse2(uint8_t *dst, const uint8_t *src, unsigned int bytes);
+#endif
+
+/* Dispatch table, see klbars-cpu.c */
+enum kl_kernel_id {
+	KL_KERNEL_UYVY_TO_V210,
+	KL_KERNEL_V210_TO_UYVY,
+	KL_KERNEL_PACK_V210,
+	KL_KERNEL_PACK_UYVY_LINE,
+	KL_KERNEL_PACK_V210_LINE,
+	KL_KERNEL_GLYPH_UYVY,
+	KL_KERNEL_GLYPH_V210,
+	KL_KERNEL_STREAM_COPY,
+	KL_KERNEL_BLEND_UYVY,
+	KL_KERNEL_BLEND_V210,
+	KL_KERNEL_UNPACK_UYVY,
+	KL_KERNEL_UNPACK_V210,
+	KL_KERNEL_LUMA_8,
+	KL_KERNEL_LUMA_16,
+	KL_KERNEL_CHROMA_NV12,
+	KL_KERNEL_CHROMA_I420,
+	KL_KERNEL_CHROMA_P010,
+	KL_KERNEL_UYVY16,
+	KL_KERNEL_RGB_BGRA,
+	KL_KERNEL_RGB_R210,
+	KL_KERNEL_RGB_R12B,
+	KL_KERNEL_TONE_S16,
+	KL_KERNEL_TONE_S32,
+	KL_KERNEL_TONE_F32,
+	KL_KERNEL_SINE_FILL,
+	KL_KERNEL_LUMA_SUM_UYVY,
+	KL_KERNEL_LUMA_SUM_V210,
+	KL_KERNEL_COMP_SUM,
+	KL_KERNEL_MAX
+};
+
+struct kl_kernels {
+	kl_line_convert_fn uyvy_to_v210_line;
+	kl_line_convert_fn v210_to_uyvy_line;
+	void (*pack_v210_group)(uint16_t y0, uint16_t cb, uint16_t cr, uint8_t *bar10);
+	void (*pack_uyvy_line)(const uint16_t *comp, uint8_t *dst, unsigned int count);
+	void (*pack_v210_line)(const uint16_t *comp, uint8_t *dst, unsigned int count);
+	void (*glyph_uyvy)(uint8_t *dst, unsigned int stride, uint8_t letter,
+			   int plotctrl, int repeat, const uint8_t *fg, const uint8_t *bg);
+	void (*glyph_v210)(uint8_t *dst, unsigned int stride, uint8_t letter,
+			   int plotctrl, int repeat, const uint8_t *bar10_fg,
+			   const uint8_t *bar10_bg);
+	kl_row_copy_fn stream_copy;
+	kl_blend_fn blend_uyvy;
+	kl_blend_fn blend_v210;
+	kl_unpack_fn unpack_uyvy_line;
+	kl_unpack_fn unpack_v210_line;
+	kl_plane_line_fn luma_8;
+	kl_plane_line_fn luma_16;
+	kl_chroma_fn chroma_nv12;
+	kl_chroma_fn chroma_i420;
+	kl_chroma_fn chroma_p010;
+	kl_plane_line_fn uyvy16_line;
+	kl_rgb_fn rgb_bgra;
+	kl_rgb_fn rgb_r210;
+	kl_rgb_fn rgb_r12b;
+	kl_tone_pack_fn tone_s16;
+	kl_tone_pack_fn tone_s32;
+	kl_tone_pack_fn tone_f32;
+	kl_sine_fill_fn sine_fill;
+	kl_luma_sum_fn luma_sum_uyvy;
+	kl_luma_sum_fn luma_sum_v210;
+	kl_comp_sum_fn comp_sum;
+
+	/* Which enum kl_colorbar_cpu_level each kernel was picked from */
+	int impl[KL_KERNEL_MAX];
+};
+
+extern struct kl_kernels kl_kernels;
+
+void kl_kernels_init(void);
+
+/* Pattern rows of frames at least this big are replicated without
+   going through the cache, which they would only flush anyway */
+#define KL_STREAM_MIN_BYTES (32 * 1024 * 1024)
+
+static inline kl_row_copy_fn kl_row_copier(const struct kl_colorbar_context *ctx)
+{
+	if ((uint64_t)kl_row_bytes(ctx) * ctx->height >= KL_STREAM_MIN_BYTES)
+		return kl_kernels.stream_copy;
+	return kl_stream_copy_c;
+}
+
+#endif
@@ -0,0 +1,422 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+#include "font8x8_basic.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KL_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define KL_HAVE_X86 0
+#endif
+
+/* Pixel kernels selected at runtime through kl_kernels.  The scalar
+   versions are the reference, every other variant must produce
+   identical output. */
+
+void kl_pack_v210_group_c(uint16_t y0, uint16_t cb, uint16_t cr,
+			  uint8_t *bar10)
+{
+	bar10[0] = cb & 0xff;
+	bar10[1] = (cb >> 8) | ((y0 & 0x3f) << 2);
+	bar10[2] = (y0 >> 6) | ((cr & 0x0f) << 4);
+	bar10[3] = (cr >> 4);
+
+	bar10[4] = y0 & 0xff;
+	bar10[5] = (y0 >> 8) | ((cb & 0x3f) << 2);
+	bar10[6] = (cb >> 6) | ((y0 & 0x0f) << 4);
+	bar10[7] = (y0 >> 4);
+
+	bar10[8] = cr & 0xff;
+	bar10[9] = (cr >> 8) | ((y0 & 0x3f) << 2);
+	bar10[10] = (y0 >> 6) | ((cb & 0x0f) << 4);
+	bar10[11] = (cb >> 4);
+
+	bar10[12] = y0 & 0xff;
+	bar10[13] = (y0 >> 8) | ((cr & 0x3f) << 2);
+	bar10[14] = (cr >> 6) | ((y0 & 0x0f) << 4);
+	bar10[15] = (y0 >> 4);
+}
+
+/* Pack a line of 10-bit components, in UYVY order, down to 8-bit UYVY */
+void kl_pack_uyvy_line_c(const uint16_t *comp, uint8_t *dst, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++)
+		dst[i] = comp[i] >> 2;
+}
+
+/* Pack a line of 10-bit components, in UYVY order, into V210.  Every
+   three components make up one little-endian word, and count must be a
+   multiple of 12 (one group of six pixels). */
+void kl_pack_v210_line_c(const uint16_t *comp, uint8_t *dst, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i += 3) {
+		uint32_t word = comp[i] | (comp[i + 1] << 10) | ((uint32_t)comp[i + 2] << 20);
+		memcpy(dst, &word, sizeof(word));
+		dst += 4;
+	}
+}
+
+/* Each of the 8 font pixels across a glyph row covers plotctrl bytes,
+   and each font row is repeated over 'repeat' lines */
+void kl_glyph_uyvy_c(uint8_t *dst, unsigned int stride, uint8_t letter,
+		     int plotctrl, int repeat, const uint8_t *fg, const uint8_t *bg)
+{
+	uint8_t line;
+
+	for (int i = 0; i < 8; i++) {
+		int k = 0;
+		while (k++ < repeat) {
+			line = font8x8_basic[letter][ i ];
+			for (int j = 0; j < 8; j++) {
+				if (line & 0x01) {
+					/* font color */
+					for (int n = 0; n < plotctrl; n += 2) {
+						*(dst + n) = fg[0];
+						*(dst + n + 1) = fg[1];
+					}
+				} else {
+					/* background color */
+					for (int n = 0; n < plotctrl; n += 2) {
+						*(dst + n) = bg[0];
+						*(dst + n + 1) = bg[1];
+					}
+				}
+
+				dst += plotctrl;
+				line >>= 1;
+			}
+			dst += (stride - (plotctrl * 2 * 4));
+		}
+	}
+}
+
+/* Each font pixel covers 2 * plotctrl bytes, filled by repeating the
+   first 8 bytes of the V210 group.  That works because both the FG
+   and BG have the same chroma */
+void kl_glyph_v210_c(uint8_t *dst, unsigned int stride, uint8_t letter,
+		     int plotctrl, int repeat, const uint8_t *bar10_fg,
+		     const uint8_t *bar10_bg)
+{
+	uint8_t line;
+
+	for (int i = 0; i < 8; i++) {
+		int k = 0;
+		while (k++ < repeat) {
+			line = font8x8_basic[letter][ i ];
+			for (int j = 0; j < 8; j++) {
+				const uint8_t *bar10 = (line & 0x01) ? bar10_fg : bar10_bg;
+
+				for (int n = 0; n < plotctrl * 2; n++)
+					*(dst + n) = bar10[n % 8];
+				line >>= 1;
+				dst += plotctrl * 2;
+			}
+			dst += (stride - (plotctrl * 4 * 4));
+		}
+	}
+}
+
+/* Draw a glyph row of 'bytes' over the frame.  Where mask is set the
+   glyph is copied as is, elsewhere its background colour is mixed with
+   what is already there, alpha 64ths of the way (see KL_TEXT_OPAQUE).
+   In UYVY every byte is a component of its own. */
+void kl_blend_uyvy_c(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+		     unsigned int bytes, unsigned int alpha)
+{
+	for (unsigned int i = 0; i < bytes; i++) {
+		if (mask[i])
+			dst[i] = src[i];
+		else
+			dst[i] = (dst[i] * (64 - alpha) + src[i] * alpha + 32) >> 6;
+	}
+}
+
+/* The same in V210, where the components are the three 10-bit fields
+   of each word, and mask is the same for all four bytes of a word */
+void kl_blend_v210_c(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+		     unsigned int bytes, unsigned int alpha)
+{
+	for (unsigned int i = 0; i + 4 <= bytes; i += 4) {
+		uint32_t d, s, out = 0;
+
+		memcpy(&s, src + i, sizeof(s));
+		if (mask[i]) {
+			out = s;
+		} else {
+			memcpy(&d, dst + i, sizeof(d));
+			for (int shift = 0; shift < 30; shift += 10) {
+				uint32_t a = (d >> shift) & 0x3ff;
+				uint32_t b = (s >> shift) & 0x3ff;
+				out |= ((a * (64 - alpha) + b * alpha + 32) >> 6) << shift;
+			}
+		}
+		memcpy(dst + i, &out, sizeof(out));
+	}
+}
+
+/* Copy a row without pulling the destination into the cache, for
+   frames too big to stay there anyway.  Plain copy as the reference. */
+void kl_stream_copy_c(uint8_t *dst, const uint8_t *src, unsigned int bytes)
+{
+	memcpy(dst, src, bytes);
+}
+
+#if KL_HAVE_X86
+
+__attribute__((target("sse2")))
+void kl_pack_v210_group_sse2(uint16_t y0, uint16_t cb, uint16_t cr,
+			     uint8_t *bar10)
+{
+	/* The four words of a group are cb/y/cr, y/cb/y, cr/y/cb and
+	   y/cr/y, with the components at bits 0, 10 and 20 */
+	__m128i c0 = _mm_setr_epi32(cb, y0, cr, y0);
+	__m128i c1 = _mm_setr_epi32(y0, cb, y0, cr);
+	__m128i c2 = _mm_setr_epi32(cr, y0, cb, y0);
+	__m128i v = _mm_or_si128(_mm_or_si128(c0, _mm_slli_epi32(c1, 10)),
+				 _mm_slli_epi32(c2, 20));
+	_mm_storeu_si128((__m128i *)bar10, v);
+}
+
+__attribute__((target("sse2")))
+void kl_pack_uyvy_line_sse2(const uint16_t *comp, uint8_t *dst, unsigned int count)
+{
+	unsigned int i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m128i lo = _mm_srli_epi16(_mm_loadu_si128((const __m128i *)&comp[i]), 2);
+		__m128i hi = _mm_srli_epi16(_mm_loadu_si128((const __m128i *)&comp[i + 8]), 2);
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_packus_epi16(lo, hi));
+	}
+	kl_pack_uyvy_line_c(comp + i, dst + i, count - i);
+}
+
+__attribute__((target("ssse3")))
+void kl_pack_v210_line_ssse3(const uint16_t *comp, uint8_t *dst, unsigned int count)
+{
+	/* Zero extend components 0, 3, 6, 9 (and 1, 4, 7, 10 and 2, 5, 8,
+	   11) into 32-bit lanes, from the 16 components loaded as lo and hi */
+	const __m128i a_lo = _mm_setr_epi8(0, 1, -1, -1, 6, 7, -1, -1, 12, 13, -1, -1, -1, -1, -1, -1);
+	const __m128i a_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 3, -1, -1);
+	const __m128i b_lo = _mm_setr_epi8(2, 3, -1, -1, 8, 9, -1, -1, 14, 15, -1, -1, -1, -1, -1, -1);
+	const __m128i b_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, -1, -1);
+	const __m128i c_lo = _mm_setr_epi8(4, 5, -1, -1, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i c_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1);
+	unsigned int i = 0;
+
+	/* Consumes 12 components per pass but loads 16 */
+	for (; i + 16 <= count; i += 12) {
+		__m128i lo = _mm_loadu_si128((const __m128i *)&comp[i]);
+		__m128i hi = _mm_loadu_si128((const __m128i *)&comp[i + 8]);
+		__m128i a = _mm_or_si128(_mm_shuffle_epi8(lo, a_lo), _mm_shuffle_epi8(hi, a_hi));
+		__m128i b = _mm_or_si128(_mm_shuffle_epi8(lo, b_lo), _mm_shuffle_epi8(hi, b_hi));
+		__m128i c = _mm_or_si128(_mm_shuffle_epi8(lo, c_lo), _mm_shuffle_epi8(hi, c_hi));
+		__m128i v = _mm_or_si128(_mm_or_si128(a, _mm_slli_epi32(b, 10)),
+					 _mm_slli_epi32(c, 20));
+		_mm_storeu_si128((__m128i *)dst, v);
+		dst += 16;
+	}
+	kl_pack_v210_line_c(comp + i, dst, count - i);
+}
+
+__attribute__((target("sse2")))
+void kl_stream_copy_sse2(uint8_t *dst, const uint8_t *src, unsigned int bytes)
+{
+	unsigned int head = (16 - ((uintptr_t)dst & 15)) & 15;
+
+	if (head > bytes)
+		head = bytes;
+	memcpy(dst, src, head);
+	dst += head;
+	src += head;
+	bytes -= head;
+
+	for (; bytes >= 64; bytes -= 64) {
+		__m128i a = _mm_loadu_si128((const __m128i *)(src + 0));
+		__m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+		__m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+		__m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+		_mm_stream_si128((__m128i *)(dst + 0), a);
+		_mm_stream_si128((__m128i *)(dst + 16), b);
+		_mm_stream_si128((__m128i *)(dst + 32), c);
+		_mm_stream_si128((__m128i *)(dst + 48), d);
+		src += 64;
+		dst += 64;
+	}
+	memcpy(dst, src, bytes);
+
+	/* Streaming stores are weakly ordered, so make them visible
+	   before anyone else looks at the row */
+	_mm_sfence();
+}
+
+/* Widest glyph cell, in bytes, the SSE2 kernels handle */
+#define KL_GLYPH_MAX_CELL 64
+
+/* Expand a glyph row into cells of 'cell' bytes, where every cell is
+   either the fg or bg pattern.  The expanded row is built once per
+   font row and then stored to each of the 'repeat' lines it covers. */
+__attribute__((target("sse2")))
+static void glyph_expand_sse2(uint8_t *dst, unsigned int stride, uint8_t letter,
+			      int cell, int repeat, __m128i fg, __m128i bg)
+{
+	__m128i row[KL_GLYPH_MAX_CELL * 8 / 16];
+	int vecs = cell * 8 / 16;
+	int per = cell >= 16 ? cell / 16 : 1;
+
+	for (int i = 0; i < 8; i++) {
+		unsigned int line = font8x8_basic[letter][i];
+
+		for (int v = 0; v < vecs; v++) {
+			__m128i m;
+			if (cell == 4) {
+				unsigned int b = line >> (v * 4);
+				m = _mm_setr_epi32(-(b & 1), -((b >> 1) & 1),
+						   -((b >> 2) & 1), -((b >> 3) & 1));
+			} else if (cell == 8) {
+				unsigned int b = line >> (v * 2);
+				m = _mm_set_epi64x(-(long long)((b >> 1) & 1),
+						   -(long long)(b & 1));
+			} else {
+				m = _mm_set1_epi8(-((line >> (v / per)) & 1));
+			}
+			row[v] = _mm_or_si128(_mm_and_si128(m, fg),
+					      _mm_andnot_si128(m, bg));
+		}
+
+		for (int k = 0; k < repeat; k++) {
+			for (int v = 0; v < vecs; v++)
+				_mm_storeu_si128((__m128i *)(dst + v * 16), row[v]);
+			dst += stride;
+		}
+	}
+}
+
+/* Cells are 4 or 8 bytes, or a multiple of 16 */
+static int glyph_cell_ok(int cell)
+{
+	return cell == 4 || cell == 8 ||
+		(cell % 16 == 0 && cell <= KL_GLYPH_MAX_CELL);
+}
+
+__attribute__((target("sse2")))
+void kl_glyph_uyvy_sse2(uint8_t *dst, unsigned int stride, uint8_t letter,
+			int plotctrl, int repeat, const uint8_t *fg, const uint8_t *bg)
+{
+	if (!glyph_cell_ok(plotctrl)) {
+		kl_glyph_uyvy_c(dst, stride, letter, plotctrl, repeat, fg, bg);
+		return;
+	}
+	glyph_expand_sse2(dst, stride, letter, plotctrl, repeat,
+			  _mm_set1_epi16(fg[0] | (fg[1] << 8)),
+			  _mm_set1_epi16(bg[0] | (bg[1] << 8)));
+}
+
+__attribute__((target("sse2")))
+void kl_glyph_v210_sse2(uint8_t *dst, unsigned int stride, uint8_t letter,
+			int plotctrl, int repeat, const uint8_t *bar10_fg,
+			const uint8_t *bar10_bg)
+{
+	__m128i fg = _mm_loadl_epi64((const __m128i *)bar10_fg);
+	__m128i bg = _mm_loadl_epi64((const __m128i *)bar10_bg);
+
+	if (!glyph_cell_ok(plotctrl * 2)) {
+		kl_glyph_v210_c(dst, stride, letter, plotctrl, repeat,
+				bar10_fg, bar10_bg);
+		return;
+	}
+	glyph_expand_sse2(dst, stride, letter, plotctrl * 2, repeat,
+			  _mm_unpacklo_epi64(fg, fg), _mm_unpacklo_epi64(bg, bg));
+}
+
+/* Inside a solid bar every 16 bytes of the frame are the same, in both
+   UYVY and V210, and so are the glyph's, so a vector blended just like
+   the previous one reuses its result */
+#define KL_BLEND_SAME(d, s, m, pd, ps, pm) \
+	(_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(d, pd), \
+						       _mm_cmpeq_epi8(s, ps)), \
+					 _mm_cmpeq_epi8(m, pm))) == 0xffff)
+
+__attribute__((target("sse2")))
+void kl_blend_uyvy_sse2(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+			unsigned int bytes, unsigned int alpha)
+{
+	const __m128i a = _mm_set1_epi16(alpha);
+	const __m128i ia = _mm_set1_epi16(64 - alpha);
+	const __m128i round = _mm_set1_epi16(32);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i pd = zero, ps = zero, pm = zero, out = zero;
+	unsigned int i = 0;
+
+	for (; i + 16 <= bytes; i += 16) {
+		__m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+		__m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i m = _mm_loadu_si128((const __m128i *)(mask + i));
+
+		if (i == 0 || !KL_BLEND_SAME(d, s, m, pd, ps, pm)) {
+			__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), ia),
+						   _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), a));
+			__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), ia),
+						   _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), a));
+			__m128i mix = _mm_packus_epi16(_mm_srli_epi16(_mm_add_epi16(lo, round), 6),
+						       _mm_srli_epi16(_mm_add_epi16(hi, round), 6));
+
+			out = _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, mix));
+			pd = d;
+			ps = s;
+			pm = m;
+		}
+		_mm_storeu_si128((__m128i *)(dst + i), out);
+	}
+	kl_blend_uyvy_c(dst + i, src + i, mask + i, bytes - i, alpha);
+}
+
+/* One 10-bit field of four V210 words, already shifted down to bit 0.
+   With alpha in 64ths, the products stay within the low 16 bits of each
+   lane, so the 16-bit multiply is enough. */
+__attribute__((target("sse2")))
+static inline __m128i blend_field_sse2(__m128i d, __m128i s, __m128i a, __m128i ia)
+{
+	const __m128i field = _mm_set1_epi32(0x3ff);
+	__m128i mix = _mm_add_epi32(_mm_mullo_epi16(_mm_and_si128(d, field), ia),
+				    _mm_mullo_epi16(_mm_and_si128(s, field), a));
+
+	return _mm_srli_epi32(_mm_add_epi32(mix, _mm_set1_epi32(32)), 6);
+}
+
+__attribute__((target("sse2")))
+void kl_blend_v210_sse2(uint8_t *dst, const uint8_t *src, const uint8_t *mask,
+			unsigned int bytes, unsigned int alpha)
+{
+	const __m128i a = _mm_set1_epi32(alpha);
+	const __m128i ia = _mm_set1_epi32(64 - alpha);
+	__m128i pd, ps, pm, out;
+	unsigned int i = 0;
+
+	pd = ps = pm = out = _mm_setzero_si128();
+	for (; i + 16 <= bytes; i += 16) {
+		__m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+		__m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i m = _mm_loadu_si128((const __m128i *)(mask + i));
+
+		if (i == 0 || !KL_BLEND_SAME(d, s, m, pd, ps, pm)) {
+			__m128i mix = blend_field_sse2(d, s, a, ia);
+
+			mix = _mm_or_si128(mix, _mm_slli_epi32(blend_field_sse2(_mm_srli_epi32(d, 10),
+										_mm_srli_epi32(s, 10), a, ia), 10));
+			mix = _mm_or_si128(mix, _mm_slli_epi32(blend_field_sse2(_mm_srli_epi32(d, 20),
+										_mm_srli_epi32(s, 20), a, ia), 20));
+
+			out = _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, mix));
+			pd = d;
+			ps = s;
+			pm = m;
+		}
+		_mm_storeu_si128((__m128i *)(dst + i), out);
+	}
+	kl_blend_v210_c(dst + i, src + i, mask + i, bytes - i, alpha);
+}
+
+#endif /* KL_HAVE_X86 */
@@ -0,0 +1,152 @@
+#include <errno.h>
+#include <time.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Frames delivered on an absolute schedule.
+
+   The time of frame n is worked out from n every time, in integer
+   nanoseconds, instead of adding up a period that 1001 rates can't
+   represent exactly, so the schedule never drifts.  At 30000/1001 the
+   periods come out as 33366666 and 33366667ns, in exactly the right
+   mix.  Each frame is rendered before sleeping until its time, so
+   only the wakeup latency shows up as jitter.  A late frame isn't
+   dropped, and the ones after it go out straight away until the
+   schedule is caught up again.  With the frame pool there is no
+   waiting for a frame, though: if none is ready when one is due, that
+   one is dropped, and if the pool has had none for a whole second it
+   has stopped rendering and pacing gives up. */
+
+#define KL_NSEC 1000000000ULL
+
+static unsigned long long monotonic_now(void *priv)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * KL_NSEC + ts.tv_nsec;
+}
+
+static void monotonic_sleep_until(unsigned long long time, void *priv)
+{
+	struct timespec ts = { time / KL_NSEC, time % KL_NSEC };
+
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+}
+
+static const struct kl_colorbar_clock monotonic_clock = {
+	monotonic_now, monotonic_sleep_until, NULL
+};
+
+/* From the start to frame n */
+static uint64_t frame_offset(const struct kl_colorbar_pacing *pacing, uint64_t n)
+{
+	uint64_t t = n * pacing->fps_den;
+
+	return t / pacing->fps_num * KL_NSEC + t % pacing->fps_num * KL_NSEC / pacing->fps_num;
+}
+
+static void record_jitter(struct kl_colorbar_pacing_stats *stats, uint64_t jitter,
+			  uint64_t period)
+{
+	uint64_t us = jitter / 1000;
+	int bin = 0;
+
+	while (us && bin < KL_COLORBAR_JITTER_BINS - 1) {
+		us >>= 1;
+		bin++;
+	}
+
+	stats->frames++;
+	stats->jitter[bin]++;
+	if (jitter > stats->max_jitter_ns)
+		stats->max_jitter_ns = jitter;
+	if (jitter >= period)
+		stats->late++;
+}
+
+int kl_colorbar_pace(struct kl_colorbar_context *ctx, const struct kl_colorbar_pacing *pacing,
+		     struct kl_colorbar_pacing_stats *stats)
+{
+	const struct kl_colorbar_clock *clock;
+	struct kl_colorbar_frame own, *frame = &own;
+	unsigned char *data = NULL;
+	uint64_t start, misses = 0;
+	int ret = 0;
+
+	if ((!ctx) || (!pacing) || (!stats) || (!pacing->deliver) ||
+	    pacing->fps_num == 0 || pacing->fps_den == 0)
+		return -1;
+
+	clock = pacing->clock ? pacing->clock : &monotonic_clock;
+	memset(stats, 0, sizeof(*stats));
+
+	/* Without the frame pool, every frame is rendered here into a
+	   frame of our own */
+	if (!ctx->frame_pool) {
+		size_t bytes = kl_frame_layout(ctx, pacing->format, NULL, NULL);
+
+		if (bytes == 0)
+			return -1;
+		data = calloc(1, bytes);
+		if (data == NULL)
+			return -1;
+		kl_frame_layout(ctx, pacing->format, &own, data);
+	}
+
+	/* Frame 0 gets one period to be rendered in */
+	start = clock->now(clock->priv);
+	for (uint64_t n = 0; pacing->frames == 0 || n < pacing->frames; n++) {
+		uint64_t due = start + frame_offset(pacing, n + 1);
+		uint64_t now;
+		int stop;
+
+		if (!ctx->frame_pool) {
+			if (kl_colorbar_fill_pattern(ctx, pacing->pattern) < 0) {
+				ret = -1;
+				break;
+			}
+			if (pacing->render)
+				pacing->render(ctx, pacing->priv);
+			own.pic_count = ctx->pic_count;
+			if (kl_colorbar_finalize_planes(ctx, &own.planes) < 0) {
+				ret = -1;
+				break;
+			}
+		}
+
+		clock->sleep_until(due, clock->priv);
+
+		if (ctx->frame_pool) {
+			frame = kl_colorbar_frame_pool_get(ctx);
+			if (frame == NULL) {
+				stats->dropped++;
+				/* A second's worth, at least one frame */
+				if (++misses > ((uint64_t)pacing->fps_num + pacing->fps_den - 1) /
+					       pacing->fps_den) {
+					ret = -1;
+					break;
+				}
+				continue;
+			}
+			misses = 0;
+		}
+
+		now = clock->now(clock->priv);
+		record_jitter(stats, now > due ? now - due : 0,
+			      frame_offset(pacing, n + 2) - frame_offset(pacing, n + 1));
+
+		stop = pacing->deliver(frame, due, pacing->priv);
+		if (ctx->frame_pool)
+			kl_colorbar_frame_pool_put(ctx, frame);
+		if (stop)
+			break;
+	}
+
+	free(data);
+	return ret;
+}
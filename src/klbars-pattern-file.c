@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <float.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Text form of a pattern description, one statement per line:
+
+	# Comment
+	name <rest of the line>
+	band <height>
+	solid <width> <Y> <Cb> <Cr>
+	ramp <width> <Y> <Cb> <Cr> <Y> <Cb> <Cr>
+
+   Sizes are fractions of the frame, written either as a decimal
+   (0.125) or as a ratio (3/28).  Colours are 10-bit values, and may be
+   given in hex (0x198).  Spans belong to the band above them. */
+
+static int parse_size(const char *tok, double *out)
+{
+	char *end;
+	double v = strtod(tok, &end);
+
+	if (end == tok)
+		return -1;
+	if (*end == '/') {
+		const char *den = end + 1;
+		double d = strtod(den, &end);
+		if (end == den || !(d > 0 && d <= DBL_MAX))
+			return -1;
+		v /= d;
+	}
+	/* Written so that NaN fails too */
+	if (*end != '\0' || !(v > 0 && v <= 1))
+		return -1;
+
+	*out = v;
+	return 0;
+}
+
+static int parse_component(const char *tok, uint16_t *out)
+{
+	char *end;
+	long v;
+
+	if (tok == NULL)
+		return -1;
+	v = strtol(tok, &end, 0);
+	if (end == tok || *end != '\0' || v < 0 || v > 1023)
+		return -1;
+
+	*out = v;
+	return 0;
+}
+
+static int parse_line(struct kl_pattern_desc *desc, char *line, int *band, int *span)
+{
+	char *save;
+	char *kw;
+	char *tok;
+
+	kw = strtok_r(line, " \t", &save);
+	if (kw == NULL)
+		return 0;
+
+	if (strcmp(kw, "name") == 0) {
+		tok = strtok_r(NULL, "", &save);
+		if (tok == NULL)
+			return -1;
+		tok += strspn(tok, " \t");
+		snprintf(desc->name, sizeof(desc->name), "%s", tok);
+		return 0;
+	}
+
+	if (strcmp(kw, "band") == 0) {
+		if (*band + 1 >= KL_MAX_BANDS)
+			return -1;
+		if (*band >= 0 && *span == 0)
+			return -1;
+		(*band)++;
+		*span = 0;
+		tok = strtok_r(NULL, " \t", &save);
+		if (tok == NULL ||
+		    parse_size(tok, &desc->bands[*band].height) < 0)
+			return -1;
+	} else if (strcmp(kw, "solid") == 0 || strcmp(kw, "ramp") == 0) {
+		struct kl_span *s;
+
+		if (*band < 0 || *span >= KL_MAX_SPANS)
+			return -1;
+		s = &desc->bands[*band].spans[(*span)++];
+
+		tok = strtok_r(NULL, " \t", &save);
+		if (tok == NULL || parse_size(tok, &s->width) < 0 ||
+		    parse_component(strtok_r(NULL, " \t", &save), &s->y0) < 0 ||
+		    parse_component(strtok_r(NULL, " \t", &save), &s->cb0) < 0 ||
+		    parse_component(strtok_r(NULL, " \t", &save), &s->cr0) < 0)
+			return -1;
+
+		if (kw[0] == 'r') {
+			if (parse_component(strtok_r(NULL, " \t", &save), &s->y1) < 0 ||
+			    parse_component(strtok_r(NULL, " \t", &save), &s->cb1) < 0 ||
+			    parse_component(strtok_r(NULL, " \t", &save), &s->cr1) < 0)
+				return -1;
+		} else {
+			s->y1 = s->y0;
+			s->cb1 = s->cb0;
+			s->cr1 = s->cr0;
+		}
+	} else {
+		return -1;
+	}
+
+	/* Nothing may follow the last argument */
+	if (strtok_r(NULL, " \t", &save) != NULL)
+		return -1;
+
+	return 0;
+}
+
+int kl_colorbar_parse_pattern(const char *text)
+{
+	struct kl_pattern_desc *desc;
+	char *copy, *line, *save;
+	int band = -1, span = 0;
+	int ret = 0;
+
+	if (!text)
+		return -1;
+
+	desc = calloc(1, sizeof(*desc));
+	copy = strdup(text);
+	if (desc == NULL || copy == NULL)
+		goto fail;
+
+	snprintf(desc->name, sizeof(desc->name), "User pattern");
+
+	for (line = strtok_r(copy, "\n", &save); line;
+	     line = strtok_r(NULL, "\n", &save)) {
+		line[strcspn(line, "#\r")] = '\0';
+		if (parse_line(desc, line, &band, &span) < 0)
+			goto fail;
+	}
+
+	/* At least one band, and no empty ones */
+	if (band < 0 || span == 0)
+		goto fail;
+
+	free(copy);
+	ret = kl_pattern_register(desc);
+	if (ret < 0)
+		free(desc);
+	return ret;
+
+fail:
+	free(copy);
+	free(desc);
+	return -1;
+}
+
+int kl_colorbar_load_pattern(const char *filename)
+{
+	FILE *fp;
+	char *text = NULL;
+	size_t len = 0;
+	int ret = -1;
+
+	if (!filename)
+		return -1;
+
+	fp = fopen(filename, "r");
+	if (fp == NULL)
+		return -1;
+
+	if (fseek(fp, 0, SEEK_END) == 0) {
+		long size = ftell(fp);
+		if (size >= 0 && fseek(fp, 0, SEEK_SET) == 0) {
+			text = malloc(size + 1);
+			if (text)
+				len = fread(text, 1, size, fp);
+		}
+	}
+	fclose(fp);
+
+	if (text) {
+		text[len] = '\0';
+		ret = kl_colorbar_parse_pattern(text);
+		free(text);
+	}
+	return ret;
+}
@@ -0,0 +1,207 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* One rasterizer for every pattern.  A band row is first drawn as
+   10-bit components in UYVY order (Cb Y Cr Y ...), and then packed to
+   the frame's format, so both bit depths come out of the same
+   description with the same bar positions. */
+
+#define KL_MAX_USER_PATTERNS 64
+
+/* Patterns loaded at runtime.  Entries are never removed, so a pattern
+   id stays valid for the life of the process. */
+static pthread_mutex_t user_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct kl_pattern_desc *user_patterns[KL_MAX_USER_PATTERNS];
+static int user_count;
+
+const struct kl_pattern_desc *kl_pattern_find(const struct kl_colorbar_context *ctx,
+					      int pattern)
+{
+	const struct kl_pattern_desc *desc = NULL;
+
+	switch (pattern) {
+	case KL_COLORBAR_BLACK:
+		return &kl_pattern_black;
+	case KL_COLORBAR_EIA_189A:
+		if (ctx && kl_is_hd(ctx))
+			return &kl_pattern_eia189_hd;
+		return &kl_pattern_eia189_sd;
+	case KL_COLORBAR_SMPTE_RP_219_1:
+		return &kl_pattern_rp219_1;
+	case KL_COLORBAR_SMPTE_RP_198:
+		return &kl_pattern_rp198;
+	case KL_COLORBAR_WHITE:
+		return &kl_pattern_white;
+	default:
+		break;
+	}
+
+	pthread_mutex_lock(&user_lock);
+	if (pattern >= KL_COLORBAR_USER_PATTERN &&
+	    pattern < KL_COLORBAR_USER_PATTERN + user_count)
+		desc = user_patterns[pattern - KL_COLORBAR_USER_PATTERN];
+	pthread_mutex_unlock(&user_lock);
+
+	return desc;
+}
+
+/* Takes ownership of desc, which must have been malloc()ed */
+int kl_pattern_register(struct kl_pattern_desc *desc)
+{
+	int pattern = -1;
+
+	pthread_mutex_lock(&user_lock);
+	if (user_count < KL_MAX_USER_PATTERNS) {
+		user_patterns[user_count] = desc;
+		pattern = KL_COLORBAR_USER_PATTERN + user_count++;
+	}
+	pthread_mutex_unlock(&user_lock);
+
+	return pattern;
+}
+
+/* Pixel position of a fractional edge, on a chroma pair boundary */
+static uint32_t frac_to_pixel(double frac, uint32_t size)
+{
+	uint32_t pos = (uint32_t)(frac * size / 2 + 0.5) * 2;
+
+	return pos > size ? size : pos;
+}
+
+int kl_pattern_bands(struct kl_colorbar_context *ctx, int pattern,
+		     struct kl_band *bands)
+{
+	const struct kl_pattern_desc *desc = kl_pattern_find(ctx, pattern);
+	double edge = 0;
+	uint32_t y = 0;
+	int count = 0;
+
+	if (desc == NULL)
+		return -1;
+
+	for (int b = 0; b < KL_MAX_BANDS && desc->bands[b].height > 0; b++) {
+		uint32_t end = ctx->height;
+
+		edge += desc->bands[b].height;
+		if (b + 1 < KL_MAX_BANDS && desc->bands[b + 1].height > 0) {
+			end = (uint32_t)(edge * ctx->height + 0.5);
+			if (end > ctx->height)
+				end = ctx->height;
+			if (end < y)
+				end = y;
+		}
+
+		bands[count++] = (struct kl_band) { y, end, &desc->bands[b] };
+		y = end;
+	}
+
+	return count;
+}
+
+static uint16_t lerp(uint16_t v0, uint16_t v1, uint32_t i, uint32_t n)
+{
+	if (v0 == v1 || n < 2)
+		return v0;
+	if (i > n - 1)
+		i = n - 1;
+	return (uint16_t)(v0 + (double)(v1 - v0) * i / (n - 1) + 0.5);
+}
+
+/* Draw pixels [x0, x1) of a span, where x0 is even.  Only the first
+   'visible' of them are on screen, the rest just pad out the last
+   V210 group. */
+static void draw_span(uint16_t *comp, uint32_t x0, uint32_t x1,
+		      uint32_t visible, const struct kl_span *span)
+{
+	uint16_t *p = comp + x0 * 2;
+
+	if (span->y0 == span->y1 && span->cb0 == span->cb1 && span->cr0 == span->cr1) {
+		for (uint32_t x = x0; x < x1; x += 2) {
+			p[0] = span->cb0;
+			p[1] = span->y0;
+			p[2] = span->cr0;
+			p[3] = span->y0;
+			p += 4;
+		}
+		return;
+	}
+
+	/* Chroma is sampled at the first pixel of each pair */
+	for (uint32_t i = 0; i < x1 - x0; i += 2) {
+		p[0] = lerp(span->cb0, span->cb1, i, visible);
+		p[1] = lerp(span->y0, span->y1, i, visible);
+		p[2] = lerp(span->cr0, span->cr1, i, visible);
+		p[3] = lerp(span->y0, span->y1, i + 1, visible);
+		p += 4;
+	}
+}
+
+int kl_pattern_span_edges(const struct kl_pattern_band *band, uint32_t width,
+			  uint32_t pixels, uint32_t *edges)
+{
+	uint32_t x = 0;
+	double edge = 0;
+	int s;
+
+	edges[0] = 0;
+	for (s = 0; s < KL_MAX_SPANS && band->spans[s].width > 0; s++) {
+		uint32_t end = pixels;
+
+		edge += band->spans[s].width;
+		if (s + 1 < KL_MAX_SPANS && band->spans[s + 1].width > 0) {
+			end = frac_to_pixel(edge, width);
+			if (end < x)
+				end = x;
+		}
+		edges[s + 1] = end;
+		x = end;
+	}
+	return s;
+}
+
+void kl_pattern_components(const struct kl_pattern_band *band, uint32_t width,
+			   uint32_t pixels, uint16_t *comp)
+{
+	static const struct kl_span black = KL_SOLID(1, 64, 512, 512);
+	uint32_t edges[KL_MAX_SPANS + 1];
+	int count = kl_pattern_span_edges(band, width, pixels, edges);
+
+	for (int s = 0; s < count; s++) {
+		uint32_t visible = (edges[s + 1] < width ? edges[s + 1] : width) - edges[s];
+
+		draw_span(comp, edges[s], edges[s + 1], visible, &band->spans[s]);
+	}
+	if (edges[count] < pixels)
+		draw_span(comp, edges[count], pixels, pixels - edges[count], &black);
+}
+
+int kl_pattern_raster(struct kl_colorbar_context *ctx,
+		      const struct kl_pattern_band *band, uint32_t row_num)
+{
+	uint8_t *row = ctx->frame + ctx->stride * row_num;
+	uint16_t *comp = ctx->raster_line;
+	uint32_t pixels;
+
+	if (comp == NULL)
+		return -1;
+
+	/* V210 packs six pixels to a group, UYVY two */
+	if (ctx->colorspace == KL_COLORBAR_10BIT)
+		pixels = (ctx->width + 5) / 6 * 6;
+	else
+		pixels = (ctx->width + 1) / 2 * 2;
+
+	kl_pattern_components(band, ctx->width, pixels, comp);
+
+	if (ctx->colorspace == KL_COLORBAR_10BIT) {
+		kl_kernels.pack_v210_line(comp, row, pixels * 2);
+		memset(row + pixels / 6 * 16, 0, kl_row_bytes(ctx) - pixels / 6 * 16);
+	} else {
+		kl_kernels.pack_uyvy_line(comp, row, ctx->width * 2);
+	}
+	return 0;
+}
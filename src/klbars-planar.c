@@ -0,0 +1,267 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KL_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define KL_HAVE_X86 0
+#endif
+
+/* Kernels for the planar and 16-bit outputs of kl_colorbar_finalize_planes().
+
+   A frame line is first unpacked to 10-bit components in UYVY order
+   (Cb Y Cr Y ...), the same form the patterns are drawn in, and the
+   output planes are then written from that.  The unpacked line is only
+   a few KB, so it stays in the cache and the frame itself is still
+   read just once.  Components are narrowed to 8 bits by dropping the
+   low bits, as kl_colorbar_finalize() does, and 16-bit outputs hold
+   them in the top 10 bits. */
+
+/* 8-bit UYVY, count bytes */
+void kl_unpack_uyvy_line_c(const uint8_t *line, uint16_t *comp, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++)
+		comp[i] = line[i] << 2;
+}
+
+/* V210, count components, a multiple of 12 */
+void kl_unpack_v210_line_c(const uint8_t *line, uint16_t *comp, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i += 3) {
+		uint32_t word;
+		memcpy(&word, line, sizeof(word));
+		comp[i] = word & 0x3ff;
+		comp[i + 1] = (word >> 10) & 0x3ff;
+		comp[i + 2] = (word >> 20) & 0x3ff;
+		line += 4;
+	}
+}
+
+void kl_luma_8_c(const uint16_t *comp, void *dst, unsigned int pixels)
+{
+	uint8_t *y = dst;
+
+	for (unsigned int i = 0; i < pixels; i++)
+		y[i] = comp[i * 2 + 1] >> 2;
+}
+
+void kl_luma_16_c(const uint16_t *comp, void *dst, unsigned int pixels)
+{
+	uint16_t *y = dst;
+
+	for (unsigned int i = 0; i < pixels; i++)
+		y[i] = comp[i * 2 + 1] << 6;
+}
+
+/* Chroma of two lines, averaged for 4:2:0.  4:2:2 passes the same line
+   twice. */
+static inline uint16_t chroma_avg(const uint16_t *c0, const uint16_t *c1, unsigned int i)
+{
+	return (c0[i] + c1[i] + 1) >> 1;
+}
+
+void kl_chroma_nv12_c(const uint16_t *c0, const uint16_t *c1, void *dst0,
+		      void *dst1, unsigned int pairs)
+{
+	uint8_t *uv = dst0;
+
+	for (unsigned int i = 0; i < pairs; i++) {
+		uv[i * 2] = chroma_avg(c0, c1, i * 4) >> 2;
+		uv[i * 2 + 1] = chroma_avg(c0, c1, i * 4 + 2) >> 2;
+	}
+}
+
+void kl_chroma_i420_c(const uint16_t *c0, const uint16_t *c1, void *dst0,
+		      void *dst1, unsigned int pairs)
+{
+	uint8_t *u = dst0;
+	uint8_t *v = dst1;
+
+	for (unsigned int i = 0; i < pairs; i++) {
+		u[i] = chroma_avg(c0, c1, i * 4) >> 2;
+		v[i] = chroma_avg(c0, c1, i * 4 + 2) >> 2;
+	}
+}
+
+void kl_chroma_p010_c(const uint16_t *c0, const uint16_t *c1, void *dst0,
+		      void *dst1, unsigned int pairs)
+{
+	uint16_t *uv = dst0;
+
+	for (unsigned int i = 0; i < pairs; i++) {
+		uv[i * 2] = chroma_avg(c0, c1, i * 4) << 6;
+		uv[i * 2 + 1] = chroma_avg(c0, c1, i * 4 + 2) << 6;
+	}
+}
+
+void kl_uyvy16_line_c(const uint16_t *comp, void *dst, unsigned int count)
+{
+	uint16_t *out = dst;
+
+	for (unsigned int i = 0; i < count; i++)
+		out[i] = comp[i] << 6;
+}
+
+#if KL_HAVE_X86
+
+__attribute__((target("sse2")))
+void kl_unpack_uyvy_line_sse2(const uint8_t *line, uint16_t *comp, unsigned int count)
+{
+	const __m128i zero = _mm_setzero_si128();
+	unsigned int i = 0;
+
+	for (; i + 16 <= count; i += 16) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&line[i]);
+		_mm_storeu_si128((__m128i *)&comp[i],
+				 _mm_slli_epi16(_mm_unpacklo_epi8(in, zero), 2));
+		_mm_storeu_si128((__m128i *)&comp[i + 8],
+				 _mm_slli_epi16(_mm_unpackhi_epi8(in, zero), 2));
+	}
+	kl_unpack_uyvy_line_c(line + i, comp + i, count - i);
+}
+
+__attribute__((target("ssse3")))
+void kl_unpack_v210_line_ssse3(const uint8_t *line, uint16_t *comp, unsigned int count)
+{
+	/* After packing, the low vector holds the first component of the
+	   four words followed by the second, and the high one the third.
+	   Put them back in word order, 8 components then 4. */
+	const __m128i a01 = _mm_setr_epi8(0, 1, 8, 9, -1, -1, 2, 3, 10, 11, -1, -1, 4, 5, 12, 13);
+	const __m128i a2 = _mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1);
+	const __m128i b01 = _mm_setr_epi8(-1, -1, 6, 7, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i b2 = _mm_setr_epi8(4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i field = _mm_set1_epi32(0x3ff);
+	unsigned int i = 0;
+
+	for (; i + 12 <= count; i += 12) {
+		__m128i in = _mm_loadu_si128((const __m128i *)line);
+		__m128i f01 = _mm_packs_epi32(_mm_and_si128(in, field),
+					      _mm_and_si128(_mm_srli_epi32(in, 10), field));
+		__m128i f2 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(in, 20), field),
+					     _mm_setzero_si128());
+
+		_mm_storeu_si128((__m128i *)&comp[i],
+				 _mm_or_si128(_mm_shuffle_epi8(f01, a01), _mm_shuffle_epi8(f2, a2)));
+		_mm_storel_epi64((__m128i *)&comp[i + 8],
+				 _mm_or_si128(_mm_shuffle_epi8(f01, b01), _mm_shuffle_epi8(f2, b2)));
+		line += 16;
+	}
+	kl_unpack_v210_line_c(line, comp + i, count - i);
+}
+
+/* Luma of 8 pixels, from the odd components of two vectors */
+__attribute__((target("sse2")))
+static inline __m128i luma_8px(const uint16_t *comp)
+{
+	__m128i v0 = _mm_loadu_si128((const __m128i *)comp);
+	__m128i v1 = _mm_loadu_si128((const __m128i *)(comp + 8));
+
+	return _mm_packs_epi32(_mm_srli_epi32(v0, 16), _mm_srli_epi32(v1, 16));
+}
+
+/* Cb Cr of 4 pairs, from the even components of two vectors, averaged
+   with the other line */
+__attribute__((target("sse2")))
+static inline __m128i chroma_4pairs(const uint16_t *c0, const uint16_t *c1)
+{
+	const __m128i low = _mm_set1_epi32(0xffff);
+	__m128i a = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)c0), low),
+				    _mm_and_si128(_mm_loadu_si128((const __m128i *)(c0 + 8)), low));
+	__m128i b = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)c1), low),
+				    _mm_and_si128(_mm_loadu_si128((const __m128i *)(c1 + 8)), low));
+
+	return _mm_avg_epu16(a, b);
+}
+
+__attribute__((target("sse2")))
+void kl_luma_8_sse2(const uint16_t *comp, void *dst, unsigned int pixels)
+{
+	uint8_t *y = dst;
+	unsigned int i = 0;
+
+	for (; i + 16 <= pixels; i += 16) {
+		__m128i lo = _mm_srli_epi16(luma_8px(comp + i * 2), 2);
+		__m128i hi = _mm_srli_epi16(luma_8px(comp + i * 2 + 16), 2);
+		_mm_storeu_si128((__m128i *)&y[i], _mm_packus_epi16(lo, hi));
+	}
+	kl_luma_8_c(comp + i * 2, y + i, pixels - i);
+}
+
+__attribute__((target("sse2")))
+void kl_luma_16_sse2(const uint16_t *comp, void *dst, unsigned int pixels)
+{
+	uint16_t *y = dst;
+	unsigned int i = 0;
+
+	for (; i + 8 <= pixels; i += 8)
+		_mm_storeu_si128((__m128i *)&y[i], _mm_slli_epi16(luma_8px(comp + i * 2), 6));
+	kl_luma_16_c(comp + i * 2, y + i, pixels - i);
+}
+
+__attribute__((target("sse2")))
+void kl_chroma_nv12_sse2(const uint16_t *c0, const uint16_t *c1, void *dst0,
+			 void *dst1, unsigned int pairs)
+{
+	uint8_t *uv = dst0;
+	unsigned int i = 0;
+
+	for (; i + 8 <= pairs; i += 8) {
+		__m128i lo = _mm_srli_epi16(chroma_4pairs(c0 + i * 4, c1 + i * 4), 2);
+		__m128i hi = _mm_srli_epi16(chroma_4pairs(c0 + i * 4 + 16, c1 + i * 4 + 16), 2);
+		_mm_storeu_si128((__m128i *)&uv[i * 2], _mm_packus_epi16(lo, hi));
+	}
+	kl_chroma_nv12_c(c0 + i * 4, c1 + i * 4, uv + i * 2, NULL, pairs - i);
+}
+
+__attribute__((target("sse2")))
+void kl_chroma_i420_sse2(const uint16_t *c0, const uint16_t *c1, void *dst0,
+			 void *dst1, unsigned int pairs)
+{
+	const __m128i low = _mm_set1_epi32(0xffff);
+	uint8_t *u = dst0;
+	uint8_t *v = dst1;
+	unsigned int i = 0;
+
+	for (; i + 8 <= pairs; i += 8) {
+		__m128i lo = chroma_4pairs(c0 + i * 4, c1 + i * 4);
+		__m128i hi = chroma_4pairs(c0 + i * 4 + 16, c1 + i * 4 + 16);
+		__m128i cb = _mm_packs_epi32(_mm_and_si128(lo, low), _mm_and_si128(hi, low));
+		__m128i cr = _mm_packs_epi32(_mm_srli_epi32(lo, 16), _mm_srli_epi32(hi, 16));
+		__m128i out = _mm_packus_epi16(_mm_srli_epi16(cb, 2), _mm_srli_epi16(cr, 2));
+
+		_mm_storel_epi64((__m128i *)&u[i], out);
+		_mm_storel_epi64((__m128i *)&v[i], _mm_srli_si128(out, 8));
+	}
+	kl_chroma_i420_c(c0 + i * 4, c1 + i * 4, u + i, v + i, pairs - i);
+}
+
+__attribute__((target("sse2")))
+void kl_chroma_p010_sse2(const uint16_t *c0, const uint16_t *c1, void *dst0,
+			 void *dst1, unsigned int pairs)
+{
+	uint16_t *uv = dst0;
+	unsigned int i = 0;
+
+	for (; i + 4 <= pairs; i += 4)
+		_mm_storeu_si128((__m128i *)&uv[i * 2],
+				 _mm_slli_epi16(chroma_4pairs(c0 + i * 4, c1 + i * 4), 6));
+	kl_chroma_p010_c(c0 + i * 4, c1 + i * 4, uv + i * 2, NULL, pairs - i);
+}
+
+__attribute__((target("sse2")))
+void kl_uyvy16_line_sse2(const uint16_t *comp, void *dst, unsigned int count)
+{
+	uint16_t *out = dst;
+	unsigned int i = 0;
+
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *)&out[i],
+				 _mm_slli_epi16(_mm_loadu_si128((const __m128i *)&comp[i]), 6));
+	kl_uyvy16_line_c(comp + i, out + i, count - i);
+}
+
+#endif /* KL_HAVE_X86 */
@@ -0,0 +1,331 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KL_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define KL_HAVE_X86 0
+#endif
+
+/* RGB outputs of kl_colorbar_finalize_planes().
+
+   These take the same unpacked 10-bit lines as the planar outputs.
+   Both pixels of a pair get the pair's chroma, so bar edges stay on
+   the pixel they are drawn at, and the matrix is applied in fixed
+   point with 16-bit coefficients, which is exactly what the SSE2
+   multiply-add does, so the C and SIMD kernels agree to the bit.
+   Patterns are mostly long runs of one colour, so the SIMD kernels
+   reuse the last result whenever the input repeats. */
+
+/* Fixed point coefficients for output components of 'bits' bits, from
+   limited range 10-bit Y'CbCr.  Video levels keep the 64-940 range
+   (scaled to the output depth) instead of stretching it to full. */
+void kl_rgb_matrix_init(struct kl_rgb_matrix *m, int hd, int bits, int video_levels)
+{
+	double kr = hd ? 0.2126 : 0.299;
+	double kb = hd ? 0.0722 : 0.114;
+	double kg = 1.0 - kr - kb;
+	double scale = ldexp(1.0, bits - 10);
+	double ys, cs, offset = 0;
+	double coef[5];
+	int shift = 14;
+
+	m->max = (1 << bits) - 1;
+	if (video_levels) {
+		ys = scale;
+		cs = scale * 876.0 / 896.0;
+		offset = 64 * scale;
+	} else {
+		ys = m->max / 876.0;
+		cs = m->max / 896.0;
+	}
+
+	coef[0] = ys;
+	coef[1] = 2 * (1 - kr) * cs;
+	coef[2] = -2 * (1 - kb) * kb / kg * cs;
+	coef[3] = -2 * (1 - kr) * kr / kg * cs;
+	coef[4] = 2 * (1 - kb) * cs;
+
+	/* As much precision as still fits the biggest one in 16 bits */
+	for (int i = 0; i < 5; i++) {
+		while (fabs(coef[i]) * (1 << shift) > 32767)
+			shift--;
+	}
+
+	m->cy = lrint(coef[0] * (1 << shift));
+	m->crv = lrint(coef[1] * (1 << shift));
+	m->cgu = lrint(coef[2] * (1 << shift));
+	m->cgv = lrint(coef[3] * (1 << shift));
+	m->cbu = lrint(coef[4] * (1 << shift));
+	m->shift = shift;
+	m->bias = lrint(offset * (1 << shift)) + (1 << (shift - 1));
+}
+
+static inline int rgb_clamp(int32_t v, int max)
+{
+	if (v < 0)
+		return 0;
+	return v > max ? max : v;
+}
+
+/* Pixel i of an unpacked line */
+static inline void pixel_rgb(const struct kl_rgb_matrix *m, const uint16_t *comp,
+			     unsigned int i, int *r, int *g, int *b)
+{
+	const uint16_t *pair = comp + (i / 2) * 4;
+	int32_t y = comp[i * 2 + 1] - 64;
+	int32_t u = pair[0] - 512;
+	int32_t v = pair[2] - 512;
+	int32_t yc = m->cy * y + m->bias;
+
+	*r = rgb_clamp((yc + m->crv * v) >> m->shift, m->max);
+	*g = rgb_clamp((yc + m->cgu * u + m->cgv * v) >> m->shift, m->max);
+	*b = rgb_clamp((yc + m->cbu * u) >> m->shift, m->max);
+}
+
+void kl_rgb_bgra_c(const uint16_t *comp, void *dst, unsigned int pixels,
+		   const struct kl_rgb_matrix *m)
+{
+	uint8_t *out = dst;
+
+	for (unsigned int i = 0; i < pixels; i++) {
+		int r, g, b;
+
+		pixel_rgb(m, comp, i, &r, &g, &b);
+		out[i * 4] = b;
+		out[i * 4 + 1] = g;
+		out[i * 4 + 2] = r;
+		out[i * 4 + 3] = 0xff;
+	}
+}
+
+void kl_rgb_r210_c(const uint16_t *comp, void *dst, unsigned int pixels,
+		   const struct kl_rgb_matrix *m)
+{
+	uint8_t *out = dst;
+
+	for (unsigned int i = 0; i < pixels; i++) {
+		int r, g, b;
+		uint32_t word;
+
+		pixel_rgb(m, comp, i, &r, &g, &b);
+		word = (uint32_t)r << 20 | g << 10 | b;
+		out[i * 4] = word >> 24;
+		out[i * 4 + 1] = word >> 16;
+		out[i * 4 + 2] = word >> 8;
+		out[i * 4 + 3] = word;
+	}
+}
+
+/* 8 pixels of 12-bit R G B, one after the other from bit 0 of the first
+   word, into 9 big endian words */
+static void pack_r12b(const uint16_t *r, const uint16_t *g, const uint16_t *b,
+		      uint8_t *dst)
+{
+	uint32_t words[9] = { 0 };
+
+	for (unsigned int k = 0; k < 24; k++) {
+		const uint16_t *c = k % 3 == 0 ? r : (k % 3 == 1 ? g : b);
+		uint32_t v = c[k / 3];
+		unsigned int bit = k * 12;
+
+		words[bit / 32] |= v << (bit % 32);
+		if (bit % 32 > 20)
+			words[bit / 32 + 1] |= v >> (32 - bit % 32);
+	}
+
+	for (unsigned int w = 0; w < 9; w++) {
+		dst[w * 4] = words[w] >> 24;
+		dst[w * 4 + 1] = words[w] >> 16;
+		dst[w * 4 + 2] = words[w] >> 8;
+		dst[w * 4 + 3] = words[w];
+	}
+}
+
+void kl_rgb_r12b_c(const uint16_t *comp, void *dst, unsigned int pixels,
+		   const struct kl_rgb_matrix *m)
+{
+	uint8_t *out = dst;
+
+	for (unsigned int i = 0; i < pixels; i += 8) {
+		/* The last group of a line is padded with black */
+		uint16_t r[8] = { 0 }, g[8] = { 0 }, b[8] = { 0 };
+
+		for (unsigned int k = 0; k < 8 && i + k < pixels; k++) {
+			int pr, pg, pb;
+
+			pixel_rgb(m, comp, i + k, &pr, &pg, &pb);
+			r[k] = pr;
+			g[k] = pg;
+			b[k] = pb;
+		}
+		pack_r12b(r, g, b, out + i / 8 * 36);
+	}
+}
+
+#if KL_HAVE_X86
+
+struct rgb_sse2 {
+	__m128i offset;	/* Subtracted from Cb Y Cr Y */
+	__m128i y_cr;	/* Red, from Y Cr pairs */
+	__m128i y_cb;	/* Blue, from Y Cb pairs */
+	__m128i g_y_cb;	/* Green, from Y Cb and Y Cr pairs */
+	__m128i g_y_cr;
+	__m128i bias;
+	__m128i shift;
+	__m128i max;
+};
+
+static inline int32_t coef_pair(int16_t lo, int16_t hi)
+{
+	return (uint16_t)lo | (uint32_t)(uint16_t)hi << 16;
+}
+
+__attribute__((target("sse2")))
+static inline void rgb_setup_sse2(struct rgb_sse2 *k, const struct kl_rgb_matrix *m)
+{
+	k->offset = _mm_set1_epi32(64 << 16 | 512);
+	k->y_cr = _mm_set1_epi32(coef_pair(m->cy, m->crv));
+	k->y_cb = _mm_set1_epi32(coef_pair(m->cy, m->cbu));
+	k->g_y_cb = _mm_set1_epi32(coef_pair(m->cy, m->cgu));
+	k->g_y_cr = _mm_set1_epi32(coef_pair(0, m->cgv));
+	k->bias = _mm_set1_epi32(m->bias);
+	k->shift = _mm_cvtsi32_si128(m->shift);
+	k->max = _mm_set1_epi16(m->max);
+}
+
+/* 4 pixels from Cb0 Y0 Cr0 Y1 Cb1 Y2 Cr1 Y3, R G B in 32-bit lanes */
+__attribute__((target("sse2")))
+static inline void rgb_4px_sse2(const struct rgb_sse2 *k, __m128i c,
+				__m128i *r, __m128i *g, __m128i *b)
+{
+	__m128i y_cb, y_cr;
+
+	c = _mm_sub_epi16(c, k->offset);
+	y_cb = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(0, 3, 0, 1)),
+				   _MM_SHUFFLE(0, 3, 0, 1));
+	y_cr = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c, _MM_SHUFFLE(2, 3, 2, 1)),
+				   _MM_SHUFFLE(2, 3, 2, 1));
+
+	*r = _mm_sra_epi32(_mm_add_epi32(_mm_madd_epi16(y_cr, k->y_cr), k->bias), k->shift);
+	*b = _mm_sra_epi32(_mm_add_epi32(_mm_madd_epi16(y_cb, k->y_cb), k->bias), k->shift);
+	*g = _mm_sra_epi32(_mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(y_cb, k->g_y_cb),
+						       _mm_madd_epi16(y_cr, k->g_y_cr)),
+					 k->bias), k->shift);
+}
+
+/* Two vectors of 32-bit lanes to 16 bits, within 0..max */
+__attribute__((target("sse2")))
+static inline __m128i rgb_clamp_sse2(const struct rgb_sse2 *k, __m128i a, __m128i b)
+{
+	__m128i v = _mm_packs_epi32(a, b);
+
+	return _mm_min_epi16(_mm_max_epi16(v, _mm_setzero_si128()), k->max);
+}
+
+__attribute__((target("sse2")))
+void kl_rgb_bgra_sse2(const uint16_t *comp, void *dst, unsigned int pixels,
+		      const struct kl_rgb_matrix *m)
+{
+	const __m128i alpha = _mm_set1_epi32(0xff);
+	uint8_t *out = dst;
+	struct rgb_sse2 k;
+	__m128i prev = _mm_setzero_si128(), px = prev;
+	unsigned int i = 0;
+
+	rgb_setup_sse2(&k, m);
+	for (; i + 4 <= pixels; i += 4) {
+		__m128i c = _mm_loadu_si128((const __m128i *)(comp + i * 2));
+
+		if (i == 0 || _mm_movemask_epi8(_mm_cmpeq_epi8(c, prev)) != 0xffff) {
+			__m128i r, g, b, bytes, t;
+
+			rgb_4px_sse2(&k, c, &r, &g, &b);
+			/* B0-3 G0-3 R0-3 A0-3, then interleaved twice */
+			bytes = _mm_packus_epi16(_mm_packs_epi32(b, g), _mm_packs_epi32(r, alpha));
+			t = _mm_unpacklo_epi8(bytes, _mm_srli_si128(bytes, 8));
+			px = _mm_unpacklo_epi8(t, _mm_srli_si128(t, 8));
+			prev = c;
+		}
+		_mm_storeu_si128((__m128i *)(out + i * 4), px);
+	}
+	kl_rgb_bgra_c(comp + i * 2, out + i * 4, pixels - i, m);
+}
+
+__attribute__((target("sse2")))
+void kl_rgb_r210_sse2(const uint16_t *comp, void *dst, unsigned int pixels,
+		      const struct kl_rgb_matrix *m)
+{
+	const __m128i zero = _mm_setzero_si128();
+	uint8_t *out = dst;
+	struct rgb_sse2 k;
+	__m128i prev = zero, px = zero;
+	unsigned int i = 0;
+
+	rgb_setup_sse2(&k, m);
+	for (; i + 4 <= pixels; i += 4) {
+		__m128i c = _mm_loadu_si128((const __m128i *)(comp + i * 2));
+
+		if (i == 0 || _mm_movemask_epi8(_mm_cmpeq_epi8(c, prev)) != 0xffff) {
+			__m128i r, g, b, rg, bb;
+
+			rgb_4px_sse2(&k, c, &r, &g, &b);
+			rg = rgb_clamp_sse2(&k, r, g);
+			bb = rgb_clamp_sse2(&k, b, b);
+			px = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_unpacklo_epi16(rg, zero), 20),
+						       _mm_slli_epi32(_mm_unpackhi_epi16(rg, zero), 10)),
+					  _mm_unpacklo_epi16(bb, zero));
+			/* Big endian: swap the bytes of each half, then the halves */
+			px = _mm_or_si128(_mm_slli_epi16(px, 8), _mm_srli_epi16(px, 8));
+			px = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(2, 3, 0, 1)),
+						 _MM_SHUFFLE(2, 3, 0, 1));
+			prev = c;
+		}
+		_mm_storeu_si128((__m128i *)(out + i * 4), px);
+	}
+	kl_rgb_r210_c(comp + i * 2, out + i * 4, pixels - i, m);
+}
+
+/* The matrix is done 8 pixels at a time, but the 12-bit packing is
+   left to pack_r12b() */
+__attribute__((target("sse2")))
+void kl_rgb_r12b_sse2(const uint16_t *comp, void *dst, unsigned int pixels,
+		      const struct kl_rgb_matrix *m)
+{
+	uint8_t *out = dst;
+	struct rgb_sse2 k;
+	__m128i prev0 = _mm_setzero_si128(), prev1 = prev0;
+	unsigned int i = 0;
+
+	rgb_setup_sse2(&k, m);
+	for (; i + 8 <= pixels; i += 8) {
+		__m128i c0 = _mm_loadu_si128((const __m128i *)(comp + i * 2));
+		__m128i c1 = _mm_loadu_si128((const __m128i *)(comp + i * 2 + 8));
+		uint8_t *group = out + i / 8 * 36;
+
+		if (i > 0 && _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(c0, prev0),
+							     _mm_cmpeq_epi8(c1, prev1))) == 0xffff) {
+			memcpy(group, group - 36, 36);
+		} else {
+			__m128i r0, g0, b0, r1, g1, b1;
+			uint16_t r[8], g[8], b[8];
+
+			rgb_4px_sse2(&k, c0, &r0, &g0, &b0);
+			rgb_4px_sse2(&k, c1, &r1, &g1, &b1);
+			_mm_storeu_si128((__m128i *)r, rgb_clamp_sse2(&k, r0, r1));
+			_mm_storeu_si128((__m128i *)g, rgb_clamp_sse2(&k, g0, g1));
+			_mm_storeu_si128((__m128i *)b, rgb_clamp_sse2(&k, b0, b1));
+			pack_r12b(r, g, b, group);
+			prev0 = c0;
+			prev1 = c1;
+		}
+	}
+	kl_rgb_r12b_c(comp + i * 2, out + i / 8 * 36, pixels - i, m);
+}
+
+#endif /* KL_HAVE_X86 */
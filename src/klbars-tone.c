@@ -43,75 +43,324 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
-#include <math.h>
 #include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* The tone repeats exactly every rate / gcd(freq, rate) samples, so
+   only whole periods of it are kept and extract loops over them without
+   a seam.  The phase of each sample comes from an integer count, which
+   can't drift however long the tone plays.  Short periods are repeated
+   up to KL_TONE_MIN_SAMPLES, and at least a frame at KL_TONE_MIN_FPS,
+   so that a frame's worth of audio takes no more than two copies.
+
+   A channel is synthesized as floats and converted to the sample
+   format by the dispatched kernels, then copied to every channel that
+   plays it.  No libm call or format test is left per sample. */
+
+static unsigned int sample_bytes(enum kl_colorbar_sample_format format)
+{
+	switch (format) {
+	case KL_COLORBAR_SAMPLE_U8:
+	case KL_COLORBAR_SAMPLE_S8:
+		return 1;
+	case KL_COLORBAR_SAMPLE_U16:
+	case KL_COLORBAR_SAMPLE_S16:
+		return 2;
+	case KL_COLORBAR_SAMPLE_S24_32:
+	case KL_COLORBAR_SAMPLE_S32:
+	case KL_COLORBAR_SAMPLE_FLOAT32:
+		return 4;
+	}
+	return 0;
+}
+
+/* One channel of samples, in the format and byte order asked for */
+static void pack_samples(const float *in, unsigned char *out, size_t count,
+			 enum kl_colorbar_sample_format format, int swap)
+{
+	switch (format) {
+	case KL_COLORBAR_SAMPLE_U8:
+		for (size_t i = 0; i < count; i++)
+			out[i] = (uint8_t)((1.0 + in[i]) / 2 * 255);
+		break;
+	case KL_COLORBAR_SAMPLE_S8:
+		for (size_t i = 0; i < count; i++)
+			out[i] = (int8_t)(in[i] * 127);
+		break;
+	case KL_COLORBAR_SAMPLE_U16:
+		for (size_t i = 0; i < count; i++) {
+			uint16_t value = ((1.0 + in[i]) / 2 * 65535);
+
+			if (swap)
+				value = (value << 8) | (value >> 8);
+			memcpy(out + i * 2, &value, 2);
+		}
+		break;
+	case KL_COLORBAR_SAMPLE_S16:
+		kl_kernels.tone_s16(in, out, count, 32767.0f, swap);
+		break;
+	case KL_COLORBAR_SAMPLE_S24_32:
+		kl_kernels.tone_s32(in, out, count, 8388607.0f, swap);
+		break;
+	case KL_COLORBAR_SAMPLE_S32:
+		kl_kernels.tone_s32(in, out, count, 2147483647.0f, swap);
+		break;
+	case KL_COLORBAR_SAMPLE_FLOAT32:
+		kl_kernels.tone_f32(in, out, count, 1.0f, swap);
+		break;
+	}
+}
+
+int kl_tone_alloc(struct kl_colorbar_audio_context *audio_ctx,
+		  enum kl_colorbar_sample_format format, unsigned int flags,
+		  int channelCount, size_t samples)
+{
+	const unsigned int bytes = sample_bytes(format);
+
+	memset(audio_ctx, 0, sizeof(struct kl_colorbar_audio_context));
+
+	if (channelCount <= 0 || bytes == 0 || samples == 0)
+		return -1;
+
+	kl_kernels_init();
+
+	audio_ctx->audio_data_size = samples * channelCount * bytes;
+	audio_ctx->audio_data = calloc(1, audio_ctx->audio_data_size);
+	if (audio_ctx->audio_data == NULL) {
+		audio_ctx->audio_data_size = 0;
+		return -1;
+	}
+
+	audio_ctx->format = format;
+	audio_ctx->flags = flags;
+	audio_ctx->channels = channelCount;
+	audio_ctx->sample_bytes = bytes;
+	audio_ctx->samples = samples;
+	return 0;
+}
+
+int kl_tone_set_channels(struct kl_colorbar_audio_context *audio_ctx, unsigned int first,
+			 unsigned int count, const float *wave)
+{
+	const int big_endian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+	const int swap = !!(audio_ctx->flags & KL_COLORBAR_AUDIO_BIG_ENDIAN) != big_endian;
+	const size_t samples = audio_ctx->samples;
+	const unsigned int bytes = audio_ctx->sample_bytes;
+	unsigned char *mono;
+
+	if (first + count > audio_ctx->channels)
+		return -1;
+
+	mono = malloc(samples * bytes);
+	if (mono == NULL)
+		return -1;
+	pack_samples(wave, mono, samples, audio_ctx->format, swap);
+
+	if (audio_ctx->flags & KL_COLORBAR_AUDIO_PLANAR) {
+		for (unsigned int c = first; c < first + count; c++)
+			memcpy(audio_ctx->audio_data + c * samples * bytes, mono, samples * bytes);
+	} else {
+		const size_t stride = (size_t)audio_ctx->channels * bytes;
+		unsigned char *ptr = audio_ctx->audio_data + first * bytes;
+
+		for (size_t i = 0; i < samples; i++) {
+			for (unsigned int c = 0; c < count; c++)
+				memcpy(ptr + c * bytes, mono + i * bytes, bytes);
+			ptr += stride;
+		}
+	}
+	free(mono);
+	return 0;
+}
+
+int kl_tone_sine(float *wave, size_t samples, int64_t freq, int sampleRate,
+		 unsigned int quarters, float level)
+{
+	uint32_t modulus, step, phase;
+
+	if (sampleRate <= 0 || sampleRate > KL_TONE_MAX_RATE)
+		return -1;
+
+	/* The phase counts cycles in units of 1 / (4 * rate), so that a
+	   whole quarter cycle is exact too */
+	modulus = (uint32_t)sampleRate * 4;
+	step = ((freq % sampleRate + sampleRate) % sampleRate) * 4;
+	phase = quarters % 4 * (uint32_t)sampleRate;
+
+	kl_kernels_init();
+	while (samples > 0) {
+		unsigned int count = samples > 65536 ? 65536 : samples;
+
+		kl_kernels.sine_fill(wave, count, step, modulus, phase, level);
+		phase = (phase + (uint64_t)step * count) % modulus;
+		wave += count;
+		samples -= count;
+	}
+	return 0;
+}
+
+uint64_t kl_tone_loop_samples(uint64_t period, int sampleRate)
+{
+	uint64_t min = (sampleRate + KL_TONE_MIN_FPS - 1) / KL_TONE_MIN_FPS;
+
+	if (min < KL_TONE_MIN_SAMPLES)
+		min = KL_TONE_MIN_SAMPLES;
+	return period * ((min + period - 1) / period);
+}
+
+int kl_colorbar_tonegenerator_create(struct kl_colorbar_audio_context *audio_ctx,
+				     int toneFreqHz, enum kl_colorbar_sample_format format,
+				     unsigned int flags, int channelCount, int sampleRate)
+{
+	if (sampleRate <= 0) {
+		memset(audio_ctx, 0, sizeof(struct kl_colorbar_audio_context));
+		return -1;
+	}
+
+	/* Cycles per sample is freq / rate, taken modulo whole cycles */
+	int64_t freq = ((int64_t)toneFreqHz % sampleRate + sampleRate) % sampleRate;
+	int64_t period = sampleRate / kl_gcd64(freq, sampleRate);
+	size_t samples = kl_tone_loop_samples(period, sampleRate);
+	float *wave;
+
+	if (kl_tone_alloc(audio_ctx, format, flags, channelCount, samples) < 0)
+		return -1;
+
+	wave = malloc(samples * sizeof(float));
+	if (wave == NULL) {
+		kl_colorbar_tonegenerator_free(audio_ctx);
+		return -1;
+	}
+	if (kl_tone_sine(wave, samples, freq, sampleRate, 0, 1.0f) < 0 ||
+	    kl_tone_set_channels(audio_ctx, 0, channelCount, wave) < 0) {
+		free(wave);
+		kl_colorbar_tonegenerator_free(audio_ctx);
+		return -1;
+	}
+	free(wave);
+	return 0;
+}
 
 int kl_colorbar_tonegenerator(struct kl_colorbar_audio_context *audio_ctx,
                               int toneFreqHz, int sampleSize,
 			      int channelCount, int durationUs,
                               int sampleRate, int signedSample)
 {
-	const int channelBytes = sampleSize / 8;
+	const int big_endian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+	enum kl_colorbar_sample_format format;
 
-	memset(audio_ctx, 0, sizeof(struct kl_colorbar_audio_context));
+	if (sampleSize == 8)
+		format = signedSample ? KL_COLORBAR_SAMPLE_S8 : KL_COLORBAR_SAMPLE_U8;
+	else if (sampleSize == 16)
+		format = signedSample ? KL_COLORBAR_SAMPLE_S16 : KL_COLORBAR_SAMPLE_U16;
+	else {
+		memset(audio_ctx, 0, sizeof(struct kl_colorbar_audio_context));
+		return -1;
+	}
+
+	return kl_colorbar_tonegenerator_create(audio_ctx, toneFreqHz, format,
+						big_endian ? KL_COLORBAR_AUDIO_BIG_ENDIAN : 0,
+						channelCount, sampleRate);
+}
 
-	int64_t length = (int64_t) sampleRate * (int64_t) channelCount * (sampleSize / 8)
-		* (int64_t) durationUs / 1000000;
+/* What a cursor wraps round: the interleaved data, or one plane */
+static size_t loop_size(const struct kl_colorbar_audio_context *audio_ctx)
+{
+	if (audio_ctx->flags & KL_COLORBAR_AUDIO_PLANAR)
+		return audio_ctx->samples * audio_ctx->sample_bytes;
+	return audio_ctx->audio_data_size;
+}
 
-	audio_ctx->audio_data_size = length;
-	audio_ctx->audio_data = malloc(length);
-	if (audio_ctx->audio_data == NULL)
+int kl_colorbar_tonegenerator_peek(const struct kl_colorbar_audio_context *audio_ctx,
+				   const struct kl_colorbar_audio_cursor *cursor, size_t bytes,
+				   struct kl_colorbar_audio_span *spans)
+{
+	size_t size, location;
+
+	if ((!audio_ctx) || (!spans) || audio_ctx->audio_data_size == 0)
 		return -1;
 
-	unsigned char *ptr = audio_ctx->audio_data;
-	int sampleIndex = 0;
-
-	while (length >= channelBytes) {
-		double x = sin(2 * M_PI * toneFreqHz * (double)(sampleIndex % sampleRate) / sampleRate);
-		for (int i=0; i < channelCount; ++i) {
-			if (sampleSize == 8 && !signedSample) {
-				const uint8_t value = ((1.0 + x) / 2 * 255);
-				*ptr = value;
-			} else if (sampleSize == 8 && signedSample) {
-				const int8_t value = (x * 127);
-				*ptr = value;
-			} else if (sampleSize == 16 && !signedSample) {
-				uint16_t value = ((1.0 + x) / 2 * 65535);
-				uint16_t *tmp = (uint16_t *) ptr;
-				*tmp = value; /* FIXME: endianness */
-			} else if (sampleSize == 16 && signedSample) {
-				int16_t value = (x * 32767);
-				int16_t *tmp = (int16_t *) ptr;
-				*tmp = value; /* FIXME: endianness */
-			}
-
-			ptr += channelBytes;
-			length -= channelBytes;
-		}
-		++sampleIndex;
+	size = loop_size(audio_ctx);
+	location = cursor ? cursor->location : audio_ctx->currentLocation;
+	if (location >= size)
+		return -1;
+	if (bytes > size)
+		bytes = size;
+
+	spans[0].data = audio_ctx->audio_data + location;
+	spans[0].size = size - location;
+	if (spans[0].size >= bytes) {
+		spans[0].size = bytes;
+		return 1;
 	}
+	spans[1].data = audio_ctx->audio_data;
+	spans[1].size = bytes - spans[0].size;
+	return 2;
+}
+
+int kl_colorbar_tonegenerator_advance(struct kl_colorbar_audio_context *audio_ctx,
+				      struct kl_colorbar_audio_cursor *cursor, size_t bytes)
+{
+	size_t *location;
+
+	if ((!audio_ctx) || audio_ctx->audio_data_size == 0)
+		return -1;
+
+	location = cursor ? &cursor->location : &audio_ctx->currentLocation;
+	*location = (*location + bytes % loop_size(audio_ctx)) % loop_size(audio_ctx);
 	return 0;
 }
 
 void kl_colorbar_tonegenerator_extract(struct kl_colorbar_audio_context *audio_ctx,
                                        unsigned char *buf, size_t bufSize)
 {
-	size_t c1_size, c2_size;
+	struct kl_colorbar_audio_span spans[2];
 
-	if (audio_ctx->currentLocation + bufSize < audio_ctx->audio_data_size) {
-		memcpy(buf, audio_ctx->audio_data + audio_ctx->currentLocation, bufSize);
-		audio_ctx->currentLocation += bufSize;
-	} else {
-		c1_size = audio_ctx->audio_data_size - audio_ctx->currentLocation;
-		c2_size = bufSize - (audio_ctx->audio_data_size - audio_ctx->currentLocation);
+	if (audio_ctx->flags & KL_COLORBAR_AUDIO_PLANAR)
+		return;
 
-		memcpy(buf, audio_ctx->audio_data + audio_ctx->currentLocation, c1_size);
-		memcpy(buf + c1_size, audio_ctx->audio_data, c2_size);
-		audio_ctx->currentLocation = c2_size;
+	/* As many times round the periods as it takes */
+	while (bufSize > 0) {
+		int count = kl_colorbar_tonegenerator_peek(audio_ctx, NULL, bufSize, spans);
+
+		if (count < 0)
+			return;
+		for (int i = 0; i < count; i++) {
+			memcpy(buf, spans[i].data, spans[i].size);
+			buf += spans[i].size;
+			bufSize -= spans[i].size;
+			kl_colorbar_tonegenerator_advance(audio_ctx, NULL, spans[i].size);
+		}
+	}
+}
+
+int kl_colorbar_tonegenerator_extract_planar(struct kl_colorbar_audio_context *audio_ctx,
+					     unsigned char **planes, size_t sampleCount)
+{
+	struct kl_colorbar_audio_span spans[2];
+	size_t plane_size, bytes, done = 0;
+
+	if ((!audio_ctx) || (!planes) || audio_ctx->audio_data_size == 0 ||
+	    !(audio_ctx->flags & KL_COLORBAR_AUDIO_PLANAR))
+		return -1;
+
+	plane_size = loop_size(audio_ctx);
+	bytes = sampleCount * audio_ctx->sample_bytes;
+	while (done < bytes) {
+		int count = kl_colorbar_tonegenerator_peek(audio_ctx, NULL, bytes - done, spans);
+
+		for (int i = 0; i < count; i++) {
+			for (unsigned int c = 0; c < audio_ctx->channels; c++)
+				memcpy(planes[c] + done, spans[i].data + c * plane_size, spans[i].size);
+			done += spans[i].size;
+			kl_colorbar_tonegenerator_advance(audio_ctx, NULL, spans[i].size);
+		}
 	}
+	return 0;
 }
 
 void kl_colorbar_tonegenerator_free(struct kl_colorbar_audio_context *ctx)
 {
 	free(ctx->audio_data);
+	memset(ctx, 0, sizeof(*ctx));
 }
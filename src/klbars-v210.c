@@ -0,0 +1,230 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KL_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define KL_HAVE_X86 0
+#endif
+
+/* Line converters used by kl_colorbar_finalize().
+
+   The scalar versions are the reference implementation, and the
+   SIMD versions must produce byte-for-byte identical output,
+   including the handling of the partial word at the end of each
+   line.  The SIMD loops only ever process whole groups which the
+   scalar loop would have processed anyway, and then hand off the
+   remainder to the exact same scalar code. */
+
+/* 8-bit UYVY -> 10-bit V210.  Every three input bytes are widened to
+   10 bits and packed into one little-endian 32-bit word. */
+static void uyvy_to_v210_tail(const uint8_t *line, uint8_t *buf,
+			      unsigned int width, int x, int n)
+{
+	for (; x < ((int)width - 2) * 2; x+= 3) {
+		buf[n] = line[x] << 2;
+		buf[n+1] = (line[x] >> 6) | (line[x+1] << 4);
+		buf[n+2] = (line[x+1] >> 4) | (line [x+2] << 6);
+		buf[n+3] = (line[x+2] >> 2);
+		n += 4;
+	}
+
+	/* Each increment of the above loop processes 1.5
+	   pixels on the input buffer, so we need deal with the
+	   remainder */
+	buf[n] = line[x] << 2;
+	buf[n+1] = (line[x] >> 6) | (line[x+1] << 4);
+	buf[n+2] = (line[x+1] >> 4);
+}
+
+void kl_uyvy_to_v210_line_c(const uint8_t *line, uint8_t *buf,
+			    unsigned int width)
+{
+	uyvy_to_v210_tail(line, buf, width, 0, 0);
+}
+
+/* 10-bit V210 -> 8-bit UYVY.  Every 32-bit word yields three bytes,
+   keeping the upper 8 bits of each 10-bit component. */
+static void v210_to_uyvy_tail(const uint8_t *line, uint8_t *buf,
+			      unsigned int width, int x, int n)
+{
+	int line_width = width * 16 / 6;
+
+	for (; x < (line_width - 4); x+= 4) {
+		uint32_t val;
+		memcpy(&val, &line[x], sizeof(val));
+		buf[n++] = val >> 2;
+		buf[n++] = val >> 12;
+		buf[n++] = val >> 22;
+	}
+}
+
+void kl_v210_to_uyvy_line_c(const uint8_t *line, uint8_t *buf,
+			    unsigned int width)
+{
+	v210_to_uyvy_tail(line, buf, width, 0, 0);
+}
+
+#if KL_HAVE_X86
+
+/* Spread the three bytes of each 3-byte group out into the low byte
+   of a 32-bit lane.  Indexes with the high bit set produce zero. */
+#define KL_SPREAD(o) \
+	_mm_setr_epi8(0 + o, -1, -1, -1, 3 + o, -1, -1, -1, \
+		      6 + o, -1, -1, -1, 9 + o, -1, -1, -1)
+
+/* Gather bytes 0..2 of every 32-bit lane into 12 contiguous bytes */
+#define KL_GATHER \
+	_mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1)
+
+__attribute__((target("ssse3")))
+static inline __m128i pack_v210_4words(__m128i in)
+{
+	__m128i a = _mm_shuffle_epi8(in, KL_SPREAD(0));
+	__m128i b = _mm_shuffle_epi8(in, KL_SPREAD(1));
+	__m128i c = _mm_shuffle_epi8(in, KL_SPREAD(2));
+
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a, 2),
+					 _mm_slli_epi32(b, 12)),
+			    _mm_slli_epi32(c, 22));
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i unpack_v210_4words(__m128i in)
+{
+	const __m128i mask = _mm_set1_epi32(0xff);
+	__m128i a = _mm_and_si128(_mm_srli_epi32(in, 2), mask);
+	__m128i b = _mm_and_si128(_mm_srli_epi32(in, 12), mask);
+	__m128i c = _mm_and_si128(_mm_srli_epi32(in, 22), mask);
+
+	__m128i v = _mm_or_si128(_mm_or_si128(a, _mm_slli_epi32(b, 8)),
+				 _mm_slli_epi32(c, 16));
+	return _mm_shuffle_epi8(v, KL_GATHER);
+}
+
+__attribute__((target("ssse3")))
+void kl_uyvy_to_v210_line_ssse3(const uint8_t *line, uint8_t *buf,
+				unsigned int width)
+{
+	int limit = ((int)width - 2) * 2;
+	int x = 0;
+	int n = 0;
+
+	/* Consume 12 bytes per pass but load 16, so stay clear of the
+	   end of the source line */
+	while (x + 12 <= limit && x + 16 <= (int)width * 2) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&line[x]);
+		_mm_storeu_si128((__m128i *)&buf[n], pack_v210_4words(in));
+		x += 12;
+		n += 16;
+	}
+	uyvy_to_v210_tail(line, buf, width, x, n);
+}
+
+__attribute__((target("avx2")))
+void kl_uyvy_to_v210_line_avx2(const uint8_t *line, uint8_t *buf,
+			       unsigned int width)
+{
+	int limit = ((int)width - 2) * 2;
+	int x = 0;
+	int n = 0;
+
+	const __m256i sa = _mm256_broadcastsi128_si256(KL_SPREAD(0));
+	const __m256i sb = _mm256_broadcastsi128_si256(KL_SPREAD(1));
+	const __m256i sc = _mm256_broadcastsi128_si256(KL_SPREAD(2));
+
+	/* 24 input bytes -> 32 output bytes, with the second half of the
+	   input loaded into the upper lane */
+	while (x + 24 <= limit && x + 28 <= (int)width * 2) {
+		__m256i in = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)&line[x])),
+			_mm_loadu_si128((const __m128i *)&line[x + 12]), 1);
+		__m256i a = _mm256_shuffle_epi8(in, sa);
+		__m256i b = _mm256_shuffle_epi8(in, sb);
+		__m256i c = _mm256_shuffle_epi8(in, sc);
+		__m256i v = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(a, 2),
+							    _mm256_slli_epi32(b, 12)),
+					    _mm256_slli_epi32(c, 22));
+		_mm256_storeu_si256((__m256i *)&buf[n], v);
+		x += 24;
+		n += 32;
+	}
+
+	while (x + 12 <= limit && x + 16 <= (int)width * 2) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&line[x]);
+		_mm_storeu_si128((__m128i *)&buf[n], pack_v210_4words(in));
+		x += 12;
+		n += 16;
+	}
+	uyvy_to_v210_tail(line, buf, width, x, n);
+}
+
+__attribute__((target("ssse3")))
+void kl_v210_to_uyvy_line_ssse3(const uint8_t *line, uint8_t *buf,
+				unsigned int width)
+{
+	int line_width = width * 16 / 6;
+	int x = 0;
+	int n = 0;
+
+	/* Only store exactly the 12 valid bytes, so we never touch
+	   anything in the destination the scalar path would not */
+	while (x + 16 <= line_width - 4) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&line[x]);
+		__m128i v = unpack_v210_4words(in);
+		uint32_t hi = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+		_mm_storel_epi64((__m128i *)&buf[n], v);
+		memcpy(&buf[n + 8], &hi, sizeof(hi));
+		x += 16;
+		n += 12;
+	}
+	v210_to_uyvy_tail(line, buf, width, x, n);
+}
+
+__attribute__((target("avx2")))
+void kl_v210_to_uyvy_line_avx2(const uint8_t *line, uint8_t *buf,
+			       unsigned int width)
+{
+	int line_width = width * 16 / 6;
+	int x = 0;
+	int n = 0;
+
+	const __m256i mask = _mm256_set1_epi32(0xff);
+	const __m256i gather = _mm256_broadcastsi128_si256(KL_GATHER);
+	/* Move the 12 valid bytes of the upper lane down next to the 12
+	   valid bytes of the lower lane */
+	const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+	while (x + 32 <= line_width - 4) {
+		__m256i in = _mm256_loadu_si256((const __m256i *)&line[x]);
+		__m256i a = _mm256_and_si256(_mm256_srli_epi32(in, 2), mask);
+		__m256i b = _mm256_and_si256(_mm256_srli_epi32(in, 12), mask);
+		__m256i c = _mm256_and_si256(_mm256_srli_epi32(in, 22), mask);
+		__m256i v = _mm256_or_si256(_mm256_or_si256(a, _mm256_slli_epi32(b, 8)),
+					    _mm256_slli_epi32(c, 16));
+		v = _mm256_shuffle_epi8(v, gather);
+		v = _mm256_permutevar8x32_epi32(v, compact);
+		_mm_storeu_si128((__m128i *)&buf[n], _mm256_castsi256_si128(v));
+		_mm_storel_epi64((__m128i *)&buf[n + 16],
+				 _mm256_extracti128_si256(v, 1));
+		x += 32;
+		n += 24;
+	}
+
+	while (x + 16 <= line_width - 4) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&line[x]);
+		__m128i v = unpack_v210_4words(in);
+		uint32_t hi = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+		_mm_storel_epi64((__m128i *)&buf[n], v);
+		memcpy(&buf[n + 8], &hi, sizeof(hi));
+		x += 16;
+		n += 12;
+	}
+	v210_to_uyvy_tail(line, buf, width, x, n);
+}
+
+#endif /* KL_HAVE_X86 */
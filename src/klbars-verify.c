@@ -0,0 +1,245 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KL_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define KL_HAVE_X86 0
+#endif
+
+/* Pattern verifier for captured frames.
+
+   The bars are laid out with the same band and span edges the pattern
+   is drawn with, and their expected levels come from the rasterizer
+   itself, so ramps and user patterns need nothing special.  Each bar
+   is measured inside an inset from its edges, on one line in every
+   KL_VERIFY_LINE_STEP: the line is unpacked to 10-bit components once,
+   and then the components under each bar are summed. */
+
+#define KL_VERIFY_LINE_STEP 2
+/* Columns and lines left out at every edge of a bar, at least these
+   many, or an eighth of the bar */
+#define KL_VERIFY_MIN_INSET_X 4
+#define KL_VERIFY_MIN_INSET_Y 2
+
+/* Sums of Cb, Y and Cr over pairs of pixels of 10-bit components */
+void kl_comp_sum_c(const uint16_t *comp, unsigned int pairs, uint32_t *sums)
+{
+	uint32_t cb = 0, y = 0, cr = 0;
+
+	for (unsigned int i = 0; i < pairs; i++) {
+		cb += comp[0];
+		y += comp[1] + comp[3];
+		cr += comp[2];
+		comp += 4;
+	}
+	sums[0] += cb;
+	sums[1] += y;
+	sums[2] += cr;
+}
+
+#if KL_HAVE_X86
+__attribute__((target("sse2")))
+void kl_comp_sum_sse2(const uint16_t *comp, unsigned int pairs, uint32_t *sums)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc = zero;
+	uint32_t lane[4];
+	unsigned int i = 0;
+
+	/* Four pairs at a time, two added together as 16 bits first */
+	for (; i + 4 <= pairs; i += 4) {
+		__m128i s = _mm_add_epi16(_mm_loadu_si128((const __m128i *)(comp + i * 4)),
+					  _mm_loadu_si128((const __m128i *)(comp + i * 4 + 8)));
+
+		acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(s, zero));
+		acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(s, zero));
+	}
+	_mm_storeu_si128((__m128i *)lane, acc);
+	sums[0] += lane[0];
+	sums[1] += lane[1] + lane[3];
+	sums[2] += lane[2];
+	kl_comp_sum_c(comp + i * 4, pairs - i, sums);
+}
+#endif
+
+/* Components in a line as unpacked, V210 in whole groups of six pixels */
+static unsigned int line_components(unsigned int width, int colorspace)
+{
+	if (colorspace == KL_COLORBAR_10BIT)
+		return (width + 5) / 6 * 12;
+	return width * 2;
+}
+
+static unsigned int inset(unsigned int size, unsigned int min)
+{
+	return size / 8 > min ? size / 8 : min;
+}
+
+int kl_colorbar_verifier_init(struct kl_colorbar_verifier *v, unsigned int width,
+			      unsigned int height, unsigned int stride, int colorspace,
+			      enum kl_colorbar_pattern pattern, unsigned int tolerance)
+{
+	struct kl_colorbar_context probe;
+	struct kl_band bands[KL_MAX_BANDS];
+	uint32_t edges[KL_MAX_SPANS + 1];
+	unsigned int pixels, count, mask;
+	int nbands;
+
+	if (v == NULL)
+		return -1;
+	memset(v, 0, sizeof(*v));
+	if (width == 0 || height == 0 ||
+	    (colorspace != KL_COLORBAR_8BIT && colorspace != KL_COLORBAR_10BIT))
+		return -1;
+	if (colorspace == KL_COLORBAR_10BIT ? stride < (width + 5) / 6 * 16 : stride < width * 2)
+		return -1;
+
+	kl_kernels_init();
+
+	/* The pattern's geometry depends only on the frame size */
+	memset(&probe, 0, sizeof(probe));
+	probe.width = width;
+	probe.height = height;
+	probe.colorspace = colorspace;
+	nbands = kl_pattern_bands(&probe, pattern, bands);
+	if (nbands < 0)
+		return -1;
+
+	pixels = (width + 5) / 6 * 6;
+	v->line = malloc(pixels * 2 * sizeof(*v->line));
+	if (v->line == NULL)
+		return -1;
+
+	v->width = width;
+	v->height = height;
+	v->stride = stride;
+	v->colorspace = colorspace;
+	v->tolerance = tolerance;
+	mask = colorspace == KL_COLORBAR_10BIT ? 0x3ff : 0x3fc;
+
+	for (int b = 0; b < nbands; b++) {
+		unsigned int dy = inset(bands[b].end - bands[b].first, KL_VERIFY_MIN_INSET_Y);
+		int spans;
+
+		if (bands[b].end < bands[b].first + 2 * dy + 1)
+			continue;
+
+		kl_pattern_components(bands[b].desc, width, pixels, v->line);
+		spans = kl_pattern_span_edges(bands[b].desc, width, pixels, edges);
+
+		for (int s = 0; s < spans; s++) {
+			struct kl_colorbar_verify_region *r = &v->region[v->regions];
+			unsigned int x1 = edges[s + 1] < width ? edges[s + 1] : width;
+			unsigned int dx, left, right;
+			uint64_t sum[3] = { 0, 0, 0 };
+
+			if (x1 <= edges[s])
+				continue;
+			dx = (inset(x1 - edges[s], KL_VERIFY_MIN_INSET_X) + 1) & ~1;
+			left = edges[s] + dx;
+			right = x1 > dx ? (x1 - dx) & ~1 : 0;
+			if (right <= left)
+				continue;
+			if (v->regions == KL_COLORBAR_VERIFY_MAX_REGIONS) {
+				kl_colorbar_verifier_free(v);
+				return -1;
+			}
+
+			/* What the bar holds at this depth, 8-bit having lost
+			   the two low bits */
+			for (unsigned int x = left; x < right; x += 2) {
+				const uint16_t *c = v->line + x * 2;
+
+				sum[0] += c[0] & mask;
+				sum[1] += (c[1] & mask) + (c[3] & mask);
+				sum[2] += c[2] & mask;
+			}
+			count = (right - left) / 2;
+
+			r->x = left;
+			r->y = bands[b].first + dy;
+			r->width = right - left;
+			r->height = bands[b].end - bands[b].first - 2 * dy;
+			r->band = b;
+			r->bar = s;
+			r->expect_cb = (double)sum[0] / count;
+			r->expect_y = (double)sum[1] / (count * 2);
+			r->expect_cr = (double)sum[2] / count;
+			v->regions++;
+		}
+	}
+	return 0;
+}
+
+int kl_colorbar_verify_frame(struct kl_colorbar_verifier *v, const unsigned char *frame)
+{
+	uint64_t sums[KL_COLORBAR_VERIFY_MAX_REGIONS][3];
+	unsigned int lines[KL_COLORBAR_VERIFY_MAX_REGIONS];
+	kl_unpack_fn unpack;
+	unsigned int comps;
+
+	if ((!v) || (!frame) || v->line == NULL)
+		return -1;
+
+	unpack = v->colorspace == KL_COLORBAR_10BIT ? kl_kernels.unpack_v210_line :
+		 kl_kernels.unpack_uyvy_line;
+	comps = line_components(v->width, v->colorspace);
+	memset(sums, 0, sizeof(sums));
+	memset(lines, 0, sizeof(lines));
+
+	/* The regions of a band are together and share their lines */
+	for (unsigned int first = 0, end; first < v->regions; first = end) {
+		const struct kl_colorbar_verify_region *r = &v->region[first];
+
+		for (end = first + 1; end < v->regions && v->region[end].band == r->band; end++)
+			;
+
+		for (unsigned int y = r->y; y < r->y + r->height; y += KL_VERIFY_LINE_STEP) {
+			unpack(frame + (size_t)v->stride * y, v->line, comps);
+			for (unsigned int i = first; i < end; i++) {
+				uint32_t line_sums[3] = { 0, 0, 0 };
+
+				kl_kernels.comp_sum(v->line + v->region[i].x * 2,
+						    v->region[i].width / 2, line_sums);
+				sums[i][0] += line_sums[0];
+				sums[i][1] += line_sums[1];
+				sums[i][2] += line_sums[2];
+				lines[i]++;
+			}
+		}
+	}
+
+	v->failed = 0;
+	for (unsigned int i = 0; i < v->regions; i++) {
+		struct kl_colorbar_verify_region *r = &v->region[i];
+		const double pairs = (double)lines[i] * (r->width / 2);
+		const double tolerance = v->tolerance;
+
+		r->error_cb = sums[i][0] / pairs - r->expect_cb;
+		r->error_y = sums[i][1] / (pairs * 2) - r->expect_y;
+		r->error_cr = sums[i][2] / pairs - r->expect_cr;
+		r->failed = fabs(r->error_y) > tolerance || fabs(r->error_cb) > tolerance ||
+			    fabs(r->error_cr) > tolerance;
+		if (r->failed)
+			v->failed++;
+	}
+
+	v->frames++;
+	if (v->failed)
+		v->failed_frames++;
+	return v->failed == 0;
+}
+
+void kl_colorbar_verifier_free(struct kl_colorbar_verifier *v)
+{
+	if (v == NULL)
+		return;
+	free(v->line);
+	v->line = NULL;
+}
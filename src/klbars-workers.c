@@ -0,0 +1,186 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "libklbars/klbars.h"
+#include "klbars-internal.h"
+
+/* Per context pool of worker threads.
+
+   A job is a function over a range of rows.  The rows are handed out
+   in bands of roughly KL_WORKER_BAND_BYTES, which each thread claims
+   in turn until none are left, so every thread works through a
+   contiguous, cache sized piece of the frame at a time.  The calling
+   thread takes bands too, rather than just sleeping until the workers
+   are done.  Every row is processed exactly as it would be single
+   threaded, so the output does not depend on the thread count. */
+
+#define KL_WORKER_BAND_BYTES (128 * 1024)
+
+/* Not worth waking the workers for less than this */
+#define KL_WORKER_MIN_BYTES (256 * 1024)
+
+struct kl_worker_pool {
+	pthread_mutex_t lock;
+	pthread_cond_t work_cond;
+	pthread_cond_t done_cond;
+	pthread_t *threads;
+	unsigned int count;
+	int quit;
+
+	/* Current job, all protected by lock */
+	kl_worker_fn fn;
+	void *arg;
+	uint32_t rows;
+	uint32_t band;
+	uint32_t next;
+	unsigned int busy;
+	unsigned int generation;
+};
+
+/* Called with the lock held, which is dropped while working */
+static void run_bands(struct kl_worker_pool *pool)
+{
+	while (pool->next < pool->rows) {
+		kl_worker_fn fn = pool->fn;
+		void *arg = pool->arg;
+		uint32_t first = pool->next;
+		uint32_t end = first + pool->band;
+
+		if (end > pool->rows)
+			end = pool->rows;
+		pool->next = end;
+
+		pthread_mutex_unlock(&pool->lock);
+		fn(arg, first, end);
+		pthread_mutex_lock(&pool->lock);
+	}
+}
+
+static void *worker_thread(void *p)
+{
+	struct kl_worker_pool *pool = p;
+	unsigned int seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	while (1) {
+		while (!pool->quit && pool->generation == seen)
+			pthread_cond_wait(&pool->work_cond, &pool->lock);
+		if (pool->quit)
+			break;
+
+		seen = pool->generation;
+		pool->busy++;
+		run_bands(pool);
+		if (--pool->busy == 0)
+			pthread_cond_signal(&pool->done_cond);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+
+static void pool_destroy(struct kl_worker_pool *pool)
+{
+	if (pool == NULL)
+		return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = 1;
+	pthread_cond_broadcast(&pool->work_cond);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (unsigned int i = 0; i < pool->count; i++)
+		pthread_join(pool->threads[i], NULL);
+
+	pthread_cond_destroy(&pool->work_cond);
+	pthread_cond_destroy(&pool->done_cond);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->threads);
+	free(pool);
+}
+
+static struct kl_worker_pool *pool_create(unsigned int count)
+{
+	struct kl_worker_pool *pool = calloc(1, sizeof(*pool));
+
+	if (pool == NULL)
+		return NULL;
+
+	pool->threads = calloc(count, sizeof(*pool->threads));
+	if (pool->threads == NULL) {
+		free(pool);
+		return NULL;
+	}
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work_cond, NULL);
+	pthread_cond_init(&pool->done_cond, NULL);
+
+	for (; pool->count < count; pool->count++) {
+		if (pthread_create(&pool->threads[pool->count], NULL,
+				   worker_thread, pool) != 0) {
+			pool_destroy(pool);
+			return NULL;
+		}
+	}
+
+	return pool;
+}
+
+void kl_workers_run(struct kl_colorbar_context *ctx, kl_worker_fn fn, void *arg,
+		    uint32_t rows, uint32_t rowBytes)
+{
+	struct kl_worker_pool *pool = ctx->workers;
+	uint32_t band;
+
+	if (pool == NULL || (uint64_t)rows * rowBytes < KL_WORKER_MIN_BYTES) {
+		fn(arg, 0, rows);
+		return;
+	}
+
+	/* Cache sized bands, but still enough of them to go round */
+	band = KL_WORKER_BAND_BYTES / (rowBytes ? rowBytes : 1);
+	if (band > rows / ((pool->count + 1) * 2))
+		band = rows / ((pool->count + 1) * 2);
+	if (band < 1)
+		band = 1;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->fn = fn;
+	pool->arg = arg;
+	pool->rows = rows;
+	pool->band = band;
+	pool->next = 0;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->work_cond);
+
+	run_bands(pool);
+	while (pool->busy > 0)
+		pthread_cond_wait(&pool->done_cond, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+void kl_workers_free(struct kl_colorbar_context *ctx)
+{
+	pool_destroy(ctx->workers);
+	ctx->workers = NULL;
+}
+
+int kl_colorbar_set_threads(struct kl_colorbar_context *ctx, unsigned int threads)
+{
+	struct kl_worker_pool *pool = NULL;
+
+	if (!ctx)
+		return -1;
+
+	/* The calling thread is one of them */
+	if (threads > 1) {
+		pool = pool_create(threads - 1);
+		if (pool == NULL)
+			return -1;
+	}
+
+	kl_workers_free(ctx);
+	ctx->workers = pool;
+	return 0;
+}
@@ -11,172 +11,490 @@
 #include "libklbars/klbars.h"
 #include "klbars-internal.h"
 
-#define ALPHA_BACKGROUND 0
-
-int kl_colorbar_init(struct kl_colorbar_context *ctx, unsigned int width,
-		     unsigned int height, int bitDepth)
+static int colorbar_setup(struct kl_colorbar_context *ctx, unsigned int width,
+			  unsigned int height, int bitDepth)
 {
 	if (!ctx)
 		return -1;
 
 	memset(ctx, 0, sizeof(*ctx));
 
+	/* Pick the pixel kernels for this CPU, first call only */
+	kl_kernels_init();
+
 	ctx->width = width;
 	ctx->height = height;
 	ctx->colorspace = bitDepth;
-	if (bitDepth == KL_COLORBAR_10BIT) {
-		/* V210 stride required by Blackmagic Decklink */
-		ctx->stride = ((width + 47) / 48) * 128;
-	} else {
-		ctx->stride = width * 2;
-	}
+	ctx->stride = kl_row_bytes(ctx);
+	ctx->fill_pattern = -1;
+	ctx->text_alpha = KL_TEXT_OPAQUE;
+
+	/* One row of components, in whole V210 groups */
+	ctx->raster_line = malloc((width + 5) / 6 * 6 * 2 * sizeof(*ctx->raster_line));
+	if (ctx->raster_line == NULL)
+		return -1;
+
+	return 0;
+}
+
+int kl_colorbar_init(struct kl_colorbar_context *ctx, unsigned int width,
+		     unsigned int height, int bitDepth)
+{
+	if (colorbar_setup(ctx, width, height, bitDepth) < 0)
+		return -1;
+
 	ctx->frame = malloc(height * ctx->stride);
-	if (ctx->frame == NULL)
+	if (ctx->frame == NULL) {
+		free(ctx->raster_line);
+		ctx->raster_line = NULL;
 		return -1;
+	}
 
 	kl_colorbar_render_reset(ctx);
 
 	return 0;
 }
 
-int kl_colorbar_finalize(struct kl_colorbar_context *ctx, unsigned char *buf,
-			 int targetColorspace, unsigned int byteStride)
+int kl_colorbar_init_external(struct kl_colorbar_context *ctx, unsigned int width,
+			      unsigned int height, int bitDepth,
+			      unsigned char *buf, unsigned int byteStride)
 {
-	if ((!ctx) || (!buf) || (byteStride == 0))
+	if (colorbar_setup(ctx, width, height, bitDepth) < 0)
 		return -1;
 
-	ctx->pic_count++;
+	ctx->external = 1;
+
+	if (kl_colorbar_attach_buffer(ctx, buf, byteStride) < 0) {
+		free(ctx->raster_line);
+		ctx->raster_line = NULL;
+		return -1;
+	}
+	return 0;
+}
+
+int kl_colorbar_attach_buffer(struct kl_colorbar_context *ctx, unsigned char *buf,
+			      unsigned int byteStride)
+{
+	if ((!ctx) || (!buf) || (!ctx->external))
+		return -1;
+
+	/* The pattern fills write whole rows, so the stride must hold at
+	   least one of them */
+	if (byteStride < kl_row_bytes(ctx))
+		return -1;
+
+	ctx->frame = buf;
+	ctx->stride = byteStride;
+
+	/* Nothing is known about what the new buffer holds */
+	ctx->fill_pattern = -1;
+	ctx->last_buf = NULL;
+	kl_clear_rows(ctx, 0, ctx->height, KL_ROW_COUNTER);
 
+	kl_colorbar_render_reset(ctx);
+
+	return 0;
+}
+
+static void finalize_line(struct kl_colorbar_context *ctx, const uint8_t *line,
+			  uint8_t *buf, int targetColorspace)
+{
 	if (ctx->colorspace == KL_COLORBAR_8BIT) {
-		if (targetColorspace == KL_COLORBAR_8BIT){
+		if (targetColorspace == KL_COLORBAR_8BIT) {
 			/* Just a straight memcpy() */
-			for (int y = 0; y < ctx->height; y++) {
-				memcpy(buf, ctx->frame + (y * ctx->stride),
-				       ctx->width * 2);
-				buf += byteStride;
-			}
+			memcpy(buf, line, ctx->width * 2);
 		} else {
-			/* Convert 8-bit to 10-bit */
-			for (int y = 0; y < ctx->height; y++) {
-				/* Note, we're simultaneously converting 8-bit to 10-bit
-				 *AND* repacking to 10-bit in the same operation, which
-				 is why this is pretty convoluted */
-
-				/* FIXME:  this just begs for some SSE optimization */
-				unsigned char *line = ctx->frame + (y * ctx->stride);
-				int n = 0;
-				int x = 0;
-				for (x = 0; x < (ctx->width - 2) * 2; x+= 3) {
-					buf[n] = line[x] << 2;
-					buf[n+1] = (line[x] >> 6) | (line[x+1] << 4);
-					buf[n+2] = (line[x+1] >> 4) | (line [x+2] << 6);
-					buf[n+3] = (line[x+2] >> 2);
-					n += 4;
-				}
-
-				/* Each increment of the above loop processes 1.5
-				   pixels on the input buffer, so we need deal with the
-				   remainder */
-				buf[n] = line[x] << 2;
-				buf[n+1] = (line[x] >> 6) | (line[x+1] << 4);
-				buf[n+2] = (line[x+1] >> 4);
-
-				buf += byteStride;
-			}
-
+			/* Convert 8-bit to 10-bit.  Note, we're simultaneously
+			   converting 8-bit to 10-bit *AND* repacking to 10-bit
+			   in the same operation */
+			kl_kernels.uyvy_to_v210_line(line, buf, ctx->width);
 		}
 	} else {
 		/* For now just handle the colorspace in 8-bit, and colorspace convert
 		   it to 10-bit on finalize */
-		if (targetColorspace == KL_COLORBAR_10BIT){
-			/* Just a straight memcpy() */
-			for (int y = 0; y < ctx->height; y++) {
-				memcpy(buf, ctx->frame + (y * ctx->stride),
-				       ctx->width * 16 / 6);
-				buf += byteStride;
-			}
+		if (targetColorspace == KL_COLORBAR_10BIT) {
+			/* Just a straight memcpy(), of whole 6 pixel groups
+			   so the last word isn't cut short */
+			memcpy(buf, line, (ctx->width + 5) / 6 * 16);
 		} else {
 			/* Convert 10-bit to 8-bit */
-			int line_width = (ctx->width) * 16 / 6;
-			for (int y = 0; y < ctx->height; y++) {
-				/* FIXME:  this just begs for some SSE optimization */
-				unsigned char *line = ctx->frame + (y * ctx->stride);
-				int n = 0;
-				int x = 0;
-                                for (x = 0; x < (line_width - 4); x+= 4) {
-					uint32_t *valptr = (uint32_t *)&line[x];
-					uint32_t val = *valptr;
-					buf[n++] = val >> 2;
-					buf[n++] = val >> 12;
-					buf[n++] = val >> 22;
-				}
-				buf += byteStride;
-			}
+			kl_kernels.v210_to_uyvy_line(line, buf, ctx->width);
 		}
 	}
-	return 0;
 }
 
-void kl_colorbar_free(struct kl_colorbar_context *ctx)
+struct finalize_job {
+	struct kl_colorbar_context *ctx;
+	unsigned char *buf;
+	int targetColorspace;
+	unsigned int byteStride;
+	int partial;
+};
+
+static void finalize_rows(void *arg, uint32_t first, uint32_t end)
 {
+	struct finalize_job *job = arg;
+	struct kl_colorbar_context *ctx = job->ctx;
+
+	for (uint32_t y = first; y < end; y++) {
+		if (job->partial && !(ctx->rowflags[y] & KL_ROW_DIRTY))
+			continue;
+		finalize_line(ctx, ctx->frame + (y * ctx->stride),
+			      job->buf + (y * job->byteStride), job->targetColorspace);
+	}
+}
+
+int kl_colorbar_finalize(struct kl_colorbar_context *ctx, unsigned char *buf,
+			 int targetColorspace, unsigned int byteStride)
+{
+	struct finalize_job job;
+	int partial;
+
 	if (!ctx)
-		return;
+		return -1;
+
+	/* Burn in this frame's counters */
+	if (kl_counters_draw(ctx) < 0)
+		return -1;
+
+	/* Rendering went straight into the caller's buffer, there is
+	   nothing left to copy */
+	if (ctx->external && targetColorspace == ctx->colorspace &&
+	    (buf == NULL || buf == ctx->frame)) {
+		ctx->pic_count++;
+		kl_clear_rows(ctx, 0, ctx->height, KL_ROW_DIRTY);
+		return 0;
+	}
+
+	if ((!buf) || (byteStride == 0) || (!ctx->frame))
+		return -1;
+
+	ctx->pic_count++;
+
+	/* The caller's buffer still holds our last frame, so only the rows
+	   which changed since then need to be written */
+	partial = ctx->rowflags && buf == ctx->last_buf &&
+		byteStride == ctx->last_stride &&
+		targetColorspace == ctx->last_target;
 
-	free(ctx->frame);
+	job = (struct finalize_job) { ctx, buf, targetColorspace, byteStride, partial };
+	kl_workers_run(ctx, finalize_rows, &job, ctx->height, kl_row_bytes(ctx));
+
+	if (ctx->rowflags) {
+		kl_clear_rows(ctx, 0, ctx->height, KL_ROW_DIRTY);
+		ctx->last_buf = buf;
+		ctx->last_stride = byteStride;
+		ctx->last_target = targetColorspace;
+	}
+	return 0;
 }
 
-void compute_colorbar_10bit_array(const uint32_t uyvy, uint8_t *bar10)
+/* Planar and RGB outputs are converted a chunk of each line at a time,
+   small enough for two unpacked lines to sit on the stack, and a
+   multiple of both the six pixel V210 group and the eight pixel R12B
+   one */
+#define KL_PLANES_CHUNK 1536
+
+struct planes_job {
+	struct kl_colorbar_context *ctx;
+	const struct kl_colorbar_planes *out;
+	int vsub; /* Lines per chroma line */
+	unsigned int planes;
+	unsigned int row_bytes[KL_COLORBAR_MAX_PLANES];
+	struct kl_rgb_matrix matrix;
+};
+
+static void unpack_chunk(struct kl_colorbar_context *ctx, uint32_t y, uint32_t x0,
+			 uint32_t n, uint16_t *comp)
 {
-	uint8_t *bar8 = (uint8_t *)&uyvy;
-	uint16_t cb, y0, cr;
+	const uint8_t *line = ctx->frame + ctx->stride * y;
+
+	if (ctx->colorspace == KL_COLORBAR_10BIT) {
+		kl_kernels.unpack_v210_line(line + x0 / 6 * 16, comp, (n + 5) / 6 * 12);
+	} else {
+		kl_kernels.unpack_uyvy_line(line + x0 * 2, comp, n * 2);
+		/* An odd width ends on half a pair, with no Cr or second Y
+		   stored.  Take the Cr of the pair before, which is almost
+		   always the same bar, or neutral chroma if there is none. */
+		if (n & 1) {
+			comp[n * 2] = n > 1 ? comp[n * 2 - 4] : 512;
+			comp[n * 2 + 1] = comp[n * 2 - 1];
+		}
+	}
+}
+
+/* Luma, or the whole line of a packed format */
+static void write_line(const struct planes_job *job, uint32_t y, uint32_t x0,
+		       uint32_t n, const uint16_t *comp)
+{
+	const struct kl_colorbar_planes *out = job->out;
+	uint8_t *p0 = out->data[0] + (size_t)out->stride[0] * y;
+
+	switch (out->format) {
+	case KL_COLORBAR_FORMAT_UYVY16:
+		kl_kernels.uyvy16_line(comp, p0 + x0 * 4, (n + 1) / 2 * 4);
+		break;
+	case KL_COLORBAR_FORMAT_BGRA:
+		kl_kernels.rgb_bgra(comp, p0 + x0 * 4, n, &job->matrix);
+		break;
+	case KL_COLORBAR_FORMAT_R210:
+		kl_kernels.rgb_r210(comp, p0 + x0 * 4, n, &job->matrix);
+		break;
+	case KL_COLORBAR_FORMAT_R12B:
+		kl_kernels.rgb_r12b(comp, p0 + x0 / 8 * 36, n, &job->matrix);
+		break;
+	case KL_COLORBAR_FORMAT_NV12:
+	case KL_COLORBAR_FORMAT_I420:
+		kl_kernels.luma_8(comp, p0 + x0, n);
+		break;
+	default:
+		kl_kernels.luma_16(comp, p0 + x0 * 2, n);
+		break;
+	}
+}
+
+static void write_chroma(const struct planes_job *job, uint32_t r, uint32_t x0,
+			 uint32_t n, const uint16_t *c0, const uint16_t *c1)
+{
+	const struct kl_colorbar_planes *out = job->out;
+	uint8_t *p1 = out->data[1] + (size_t)out->stride[1] * r;
+	uint32_t pairs = (n + 1) / 2;
+
+	switch (out->format) {
+	case KL_COLORBAR_FORMAT_NV12:
+		kl_kernels.chroma_nv12(c0, c1, p1 + x0, NULL, pairs);
+		break;
+	case KL_COLORBAR_FORMAT_I420:
+		kl_kernels.chroma_i420(c0, c1, p1 + x0 / 2,
+				       out->data[2] + (size_t)out->stride[2] * r + x0 / 2,
+				       pairs);
+		break;
+	case KL_COLORBAR_FORMAT_P010:
+	case KL_COLORBAR_FORMAT_P216:
+		kl_kernels.chroma_p010(c0, c1, p1 + x0 * 2, NULL, pairs);
+		break;
+	default:
+		break;
+	}
+}
 
-	cb = bar8[0] << 2;
-	y0 = bar8[1] << 2;
-	cr = bar8[2] << 2;
+/* Lines the same as those of the row above (as within any band of a
+   pattern) convert to the same output too */
+static int repeat_row(const struct planes_job *job, uint32_t r)
+{
+	const struct kl_colorbar_context *ctx = job->ctx;
+	const struct kl_colorbar_planes *out = job->out;
+	uint32_t y0 = r * job->vsub;
+	unsigned int lineBytes = kl_row_bytes(ctx);
+
+	if (y0 + job->vsub > ctx->height)
+		return 0;
+	for (uint32_t y = y0; y < y0 + job->vsub; y++) {
+		if (memcmp(ctx->frame + ctx->stride * y,
+			   ctx->frame + ctx->stride * (y - job->vsub), lineBytes) != 0)
+			return 0;
+	}
 
-	bar10[0] = cb & 0xff;
-	bar10[1] = (cb >> 8) | ((y0 & 0x3f) << 2);
-	bar10[2] = (y0 >> 6) | ((cr & 0x0f) << 4);
-	bar10[3] = (cr >> 4);
+	for (unsigned int i = 0; i < job->planes; i++) {
+		/* The first plane has a row per line */
+		uint32_t first = i == 0 ? y0 : r;
+		uint32_t count = i == 0 ? job->vsub : 1;
 
-	bar10[4] = y0 & 0xff;
-	bar10[5] = (y0 >> 8) | ((cb & 0x3f) << 2);
-	bar10[6] = (cb >> 6) | ((y0 & 0x0f) << 4);
-	bar10[7] = (y0 >> 4);
+		for (uint32_t y = first; y < first + count; y++) {
+			uint8_t *p = out->data[i] + (size_t)out->stride[i] * y;
+			memcpy(p, p - (size_t)out->stride[i] * count, job->row_bytes[i]);
+		}
+	}
+	return 1;
+}
 
-	bar10[8] = cr & 0xff;
-	bar10[9] = (cr >> 8) | ((y0 & 0x3f) << 2);
-	bar10[10] = (y0 >> 6) | ((cb & 0x0f) << 4);
-	bar10[11] = (cb >> 4);
+/* Rows [first, end) of the chroma planes, and the lines they cover */
+static void planes_rows(void *arg, uint32_t first, uint32_t end)
+{
+	struct planes_job *job = arg;
+	struct kl_colorbar_context *ctx = job->ctx;
+	uint16_t c0[KL_PLANES_CHUNK * 2], c1[KL_PLANES_CHUNK * 2];
+
+	for (uint32_t r = first; r < end; r++) {
+		uint32_t y0 = r * job->vsub;
+		uint32_t y1 = y0 + job->vsub - 1;
+
+		/* The row above is only known to be written when it is
+		   part of this band */
+		if (r > first && repeat_row(job, r))
+			continue;
+
+		/* An odd height leaves the last chroma row one line */
+		if (y1 >= ctx->height)
+			y1 = y0;
+
+		for (uint32_t x0 = 0; x0 < ctx->width; x0 += KL_PLANES_CHUNK) {
+			uint32_t n = ctx->width - x0;
+
+			if (n > KL_PLANES_CHUNK)
+				n = KL_PLANES_CHUNK;
+
+			unpack_chunk(ctx, y0, x0, n, c0);
+			write_line(job, y0, x0, n, c0);
+			if (y1 != y0) {
+				unpack_chunk(ctx, y1, x0, n, c1);
+				write_line(job, y1, x0, n, c1);
+				write_chroma(job, r, x0, n, c0, c1);
+			} else {
+				write_chroma(job, r, x0, n, c0, c0);
+			}
+		}
+	}
+}
 
-	bar10[12] = y0 & 0xff;
-	bar10[13] = (y0 >> 8) | ((cr & 0x3f) << 2);
-	bar10[14] = (cr >> 6) | ((y0 & 0x0f) << 4);
-	bar10[15] = (y0 >> 4);
+int kl_format_layout(const struct kl_colorbar_context *ctx, enum kl_colorbar_format format,
+		     unsigned int *row_bytes, int *vsub)
+{
+	unsigned int pairs = (ctx->width + 1) / 2;
+
+	*vsub = 1;
+	switch (format) {
+	case KL_COLORBAR_FORMAT_UYVY:
+		row_bytes[0] = ctx->width * 2;
+		return 1;
+	case KL_COLORBAR_FORMAT_V210:
+		row_bytes[0] = ((ctx->width + 47) / 48) * 128;
+		return 1;
+	case KL_COLORBAR_FORMAT_UYVY16:
+		row_bytes[0] = pairs * 8;
+		return 1;
+	case KL_COLORBAR_FORMAT_NV12:
+		row_bytes[0] = ctx->width;
+		row_bytes[1] = pairs * 2;
+		*vsub = 2;
+		return 2;
+	case KL_COLORBAR_FORMAT_I420:
+		row_bytes[0] = ctx->width;
+		row_bytes[1] = row_bytes[2] = pairs;
+		*vsub = 2;
+		return 3;
+	case KL_COLORBAR_FORMAT_P010:
+	case KL_COLORBAR_FORMAT_P216:
+		row_bytes[0] = ctx->width * 2;
+		row_bytes[1] = pairs * 4;
+		if (format == KL_COLORBAR_FORMAT_P010)
+			*vsub = 2;
+		return 2;
+	case KL_COLORBAR_FORMAT_BGRA:
+	case KL_COLORBAR_FORMAT_R210:
+		row_bytes[0] = ctx->width * 4;
+		return 1;
+	case KL_COLORBAR_FORMAT_R12B:
+		row_bytes[0] = (ctx->width + 7) / 8 * 36;
+		return 1;
+	default:
+		return -1;
+	}
 }
 
-void compute_colorbar_10bit_array2(uint16_t y0, uint16_t cb, uint16_t cr,
-				   uint8_t *bar10)
+int kl_colorbar_finalize_planes(struct kl_colorbar_context *ctx,
+				const struct kl_colorbar_planes *out)
 {
-	bar10[0] = cb & 0xff;
-	bar10[1] = (cb >> 8) | ((y0 & 0x3f) << 2);
-	bar10[2] = (y0 >> 6) | ((cr & 0x0f) << 4);
-	bar10[3] = (cr >> 4);
+	struct planes_job job;
+	int planes;
+	uint32_t rows;
+
+	if ((!ctx) || (!out))
+		return -1;
+
+	if (out->format == KL_COLORBAR_FORMAT_UYVY || out->format == KL_COLORBAR_FORMAT_V210)
+		return kl_colorbar_finalize(ctx, out->data[0], out->format, out->stride[0]);
+
+	planes = kl_format_layout(ctx, out->format, job.row_bytes, &job.vsub);
+	if (planes < 0)
+		return -1;
+	for (int i = 0; i < planes; i++) {
+		if ((!out->data[i]) || (out->stride[i] < job.row_bytes[i]))
+			return -1;
+	}
+	job.ctx = ctx;
+	job.out = out;
+	job.planes = planes;
+
+	switch (out->format) {
+	case KL_COLORBAR_FORMAT_BGRA:
+		kl_rgb_matrix_init(&job.matrix, kl_is_hd(ctx), 8, 0);
+		break;
+	case KL_COLORBAR_FORMAT_R210:
+		kl_rgb_matrix_init(&job.matrix, kl_is_hd(ctx), 10, 1);
+		break;
+	case KL_COLORBAR_FORMAT_R12B:
+		kl_rgb_matrix_init(&job.matrix, kl_is_hd(ctx), 12, 0);
+		break;
+	default:
+		break;
+	}
 
-	bar10[4] = y0 & 0xff;
-	bar10[5] = (y0 >> 8) | ((cb & 0x3f) << 2);
-	bar10[6] = (cb >> 6) | ((y0 & 0x0f) << 4);
-	bar10[7] = (y0 >> 4);
+	if (kl_counters_draw(ctx) < 0)
+		return -1;
+	if (!ctx->frame)
+		return -1;
+
+	ctx->pic_count++;
 
-	bar10[8] = cr & 0xff;
-	bar10[9] = (cr >> 8) | ((y0 & 0x3f) << 2);
-	bar10[10] = (y0 >> 6) | ((cb & 0x0f) << 4);
-	bar10[11] = (cb >> 4);
+	rows = (ctx->height + job.vsub - 1) / job.vsub;
+	kl_workers_run(ctx, planes_rows, &job, rows, kl_row_bytes(ctx) * job.vsub);
 
-	bar10[12] = y0 & 0xff;
-	bar10[13] = (y0 >> 8) | ((cr & 0x3f) << 2);
-	bar10[14] = (cr >> 6) | ((y0 & 0x0f) << 4);
-	bar10[15] = (y0 >> 4);
+	/* Every row was written, but not to a buffer finalize can update */
+	kl_clear_rows(ctx, 0, ctx->height, KL_ROW_DIRTY);
+	ctx->last_buf = NULL;
+
+	return 0;
+}
+
+int kl_colorbar_set_dirty_tracking(struct kl_colorbar_context *ctx, int enable)
+{
+	if (!ctx)
+		return -1;
+
+	free(ctx->rowflags);
+	ctx->rowflags = NULL;
+	ctx->fill_pattern = -1;
+	ctx->last_buf = NULL;
+
+	if (enable) {
+		/* Start out with everything dirty, and as if drawn over
+		   since we can't tell what was */
+		ctx->rowflags = malloc(ctx->height);
+		if (ctx->rowflags == NULL)
+			return -1;
+		memset(ctx->rowflags, KL_ROW_DIRTY | KL_ROW_OVERLAY, ctx->height);
+	}
+	return 0;
+}
+
+void kl_colorbar_free(struct kl_colorbar_context *ctx)
+{
+	if (!ctx)
+		return;
+
+	/* The producer thread is still using everything else */
+	kl_frame_pool_free(ctx);
+
+	if (ctx->use_cache) {
+		free(ctx->private_frame);
+		kl_cache_detach(ctx);
+	} else if (!ctx->external) {
+		free(ctx->frame);
+	}
+	free(ctx->rowflags);
+	kl_glyph_cache_free(ctx);
+	free(ctx->counters);
+	free(ctx->raster_line);
+	kl_workers_free(ctx);
+}
+
+void compute_colorbar_10bit_array(const uint32_t uyvy, uint8_t *bar10)
+{
+	uint8_t *bar8 = (uint8_t *)&uyvy;
+
+	kl_kernels.pack_v210_group(bar8[1] << 2, bar8[0] << 2, bar8[2] << 2,
+				   bar10);
 }
 
 int kl_colorbar_render_reset(struct kl_colorbar_context *ctx)
@@ -186,14 +504,24 @@ int kl_colorbar_render_reset(struct kl_colorbar_context *ctx)
 
 	ctx->ptr = ctx->frame;
 
+	/* Font pixels grow with the frame, so text covers about the
+	   same share of the picture at every resolution */
 	if (ctx->width < 1280) {
 		ctx->plotwidth = 8 * 2;
 		ctx->plotheight = 8 * 4;
 		ctx->plotctrl = 4;
-	} else {
+	} else if (ctx->width < 3840) {
 		ctx->plotwidth = 8 * 4;
 		ctx->plotheight = 8 * 4;
 		ctx->plotctrl = 8;
+	} else if (ctx->width < 7680) {
+		ctx->plotwidth = 8 * 8;
+		ctx->plotheight = 8 * 8;
+		ctx->plotctrl = 16;
+	} else {
+		ctx->plotwidth = 8 * 16;
+		ctx->plotheight = 8 * 16;
+		ctx->plotctrl = 32;
 	}
 
 	kl_colorbar_render_moveto(ctx, 0, 0);
@@ -203,37 +531,44 @@ int kl_colorbar_render_reset(struct kl_colorbar_context *ctx)
 
 int kl_colorbar_fill_pattern (struct kl_colorbar_context *ctx, enum kl_colorbar_pattern pattern)
 {
-	switch (pattern) {
-	case KL_COLORBAR_BLACK:
-		kl_colorbar_fill_black(ctx);
-		break;
-	case KL_COLORBAR_EIA_189A:
-		kl_colorbar_fill_colorbars(ctx);
-		break;
-	case KL_COLORBAR_SMPTE_RP_219_1:
-		kl_colorbar_fill_rp219_1(ctx);
-		break;
-	case KL_COLORBAR_SMPTE_RP_198:
-		kl_colorbar_fill_rp198(ctx);
-		break;
-	default:
+	struct kl_band bands[KL_MAX_BANDS];
+	int count, ret;
+
+	if (!ctx)
+		return -1;
+
+	/* Share a single rendering of the pattern with other contexts */
+	if (ctx->use_cache)
+		return kl_cache_fill(ctx, pattern);
+
+	count = kl_pattern_bands(ctx, pattern, bands);
+	if (count < 0)
+		return -1;
+
+	/* With dirty tracking, redrawing the pattern already in the frame
+	   only has to undo whatever was drawn over it */
+	if (ctx->rowflags && ctx->fill_pattern == pattern)
+		ret = kl_restore_bands(ctx, bands, count);
+	else
+		ret = kl_fill_bands(ctx, bands, count);
+	if (ret < 0) {
+		ctx->fill_pattern = -1;
 		return -1;
 	}
+	ctx->fill_pattern = pattern;
+
+	if (pattern == KL_COLORBAR_SMPTE_RP_198)
+		kl_colorbar_rp198_polarity(ctx);
+
 	return 0;
 }
 
 const char *kl_colorbar_get_pattern_name (struct kl_colorbar_context *ctx, enum kl_colorbar_pattern pattern)
 {
-	switch (pattern) {
-	case KL_COLORBAR_BLACK:
-		return "Black field";
-	case KL_COLORBAR_EIA_189A:
-		return "EIA-189A Colorbars";
-	case KL_COLORBAR_SMPTE_RP_219_1:
-		return "SMPTE RP 219-1 Colorbars";
-	case KL_COLORBAR_SMPTE_RP_198:
-		return "SMPTE RP 198 Checkfield";
-	default:
+	const struct kl_pattern_desc *desc = kl_pattern_find(ctx, pattern);
+
+	if (desc == NULL)
 		return NULL;
-	}
+
+	return desc->name;
 }
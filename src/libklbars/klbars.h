@@ -19,6 +19,12 @@ extern "C" {
 #define KL_COLORBAR_8BIT  0
 #define KL_COLORBAR_10BIT 1
 
+struct kl_pattern_cache_entry;
+struct kl_worker_pool;
+struct kl_glyph_cache;
+struct kl_counters;
+struct kl_frame_pool;
+
 struct kl_colorbar_context
 {
     unsigned char *frame, *ptr; /* top left of render image and a working ptr */
@@ -34,13 +40,61 @@ struct kl_colorbar_context
 
     /* Rendered font fg and bg colors */
     unsigned char bg[2], fg[2];
+    struct kl_glyph_cache *glyphs; /* Font pre-rendered in those colors */
+    int text_alpha; /* Background opacity, see kl_colorbar_set_text_background() */
+
+    int external; /* frame is caller owned, see kl_colorbar_init_external() */
+
+    /* Dirty row tracking, see kl_colorbar_set_dirty_tracking() */
+    unsigned char *rowflags;
+    int fill_pattern; /* Pattern currently in the frame, or -1 */
+    unsigned char *last_buf;
+    unsigned int last_stride;
+    int last_target;
+
+    /* Shared pattern cache, see kl_colorbar_set_pattern_cache() */
+    int use_cache;
+    struct kl_pattern_cache_entry *cache_entry; /* Pattern being shown */
+    unsigned char *private_frame; /* Copy made once text is drawn */
+    struct kl_pattern_cache_entry *private_src; /* What private_frame was copied from */
+
+    struct kl_worker_pool *workers; /* See kl_colorbar_set_threads() */
+    struct kl_counters *counters; /* See kl_colorbar_add_counter() */
+    struct kl_frame_pool *frame_pool; /* See kl_colorbar_frame_pool_start() */
+
+    unsigned short *raster_line; /* Scratch components for drawing pattern rows */
+};
+
+/**
+ * @brief       Audio sample formats, see kl_colorbar_tonegenerator_create().
+ */
+enum kl_colorbar_sample_format {
+	KL_COLORBAR_SAMPLE_U8,
+	KL_COLORBAR_SAMPLE_S8,
+	KL_COLORBAR_SAMPLE_U16,
+	KL_COLORBAR_SAMPLE_S16,
+	/** 24-bit in the low three bytes of 32, sign extended **/
+	KL_COLORBAR_SAMPLE_S24_32,
+	KL_COLORBAR_SAMPLE_S32,
+	/** -1.0 to 1.0 **/
+	KL_COLORBAR_SAMPLE_FLOAT32,
 };
 
+/* Flags for kl_colorbar_tonegenerator_create() */
+#define KL_COLORBAR_AUDIO_PLANAR     0x1 /* One plane per channel, instead of interleaved */
+#define KL_COLORBAR_AUDIO_BIG_ENDIAN 0x2 /* Instead of little endian */
+
 struct kl_colorbar_audio_context
 {
 	unsigned char *audio_data;
 	size_t audio_data_size;
-	size_t currentLocation;
+	size_t currentLocation; /* Bytes into the interleaved data, or into every plane */
+
+	enum kl_colorbar_sample_format format;
+	unsigned int flags;
+	unsigned int channels;
+	unsigned int sample_bytes;
+	size_t samples; /* Stored per channel, whole periods of the tone */
 };
 
 /**
@@ -55,15 +109,104 @@ struct kl_colorbar_audio_context
 int kl_colorbar_init(struct kl_colorbar_context *ctx, unsigned int width,
 		     unsigned int height, int bitDepth);
 
+/**
+ * @brief       Initialize a previously allocated context which renders directly into a caller owned
+ *              buffer (e.g. the bytes of a DeckLink IDeckLinkMutableVideoFrame), rather than into
+ *              a private frame which then has to be copied by kl_colorbar_finalize().
+ *              The buffer must be height * byteStride bytes, in the pixel format matching bitDepth
+ *              (UYVY or V210), and is never freed by the library.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   unsigned int width - in pixels.
+ * @param[in]   unsigned int height - in pixels.
+ * @param[in]   unsigned int bitDepth - A value of KL_COLORBAR_8BIT or KL_COLORBAR_10BIT is supported.
+ * @param[in]   unsigned char *buf - Top left of the caller's frame.
+ * @param[in]   unsigned int byteStride - Bytes between rows, at least one full row of pixels.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_init_external(struct kl_colorbar_context *ctx, unsigned int width,
+			      unsigned int height, int bitDepth,
+			      unsigned char *buf, unsigned int byteStride);
+
+/**
+ * @brief       Point a context created with kl_colorbar_init_external() at a different caller owned
+ *              buffer, typically the next frame handed out by the output driver.  The new buffer
+ *              does not carry over any of the previous content, so fill it before finalizing.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   unsigned char *buf - Top left of the caller's frame.
+ * @param[in]   unsigned int byteStride - Bytes between rows.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_attach_buffer(struct kl_colorbar_context *ctx, unsigned char *buf,
+			      unsigned int byteStride);
+
 /**
  * @brief       Put the fully compositied colorbar frame into a final user allocated buffer in the requested
- *              colorspace (TODO) and stride.
+ *              colorspace and stride.  See kl_colorbar_finalize_planes() for other output formats.
+ *              For contexts created with kl_colorbar_init_external(), when targetColorspace
+ *              matches the rendered depth and buf is NULL or the attached buffer, no copy is made.
  * @param[in]   struct kl_colorbar_context *ctx - Context.
  * @return      0 - Success
  * @return      < 0 - Error
  */
 int kl_colorbar_finalize(struct kl_colorbar_context *ctx, unsigned char *buf,
 			 int targetColorspace, unsigned int byteStride);
+/**
+ * @brief       Output formats for kl_colorbar_finalize_planes().  The 16-bit formats are little endian,
+ *              with the 10-bit value in the top bits of each word.  The RGB formats use the BT.709
+ *              matrix for frames wider than 720 pixels and BT.601 otherwise, the same split as the
+ *              EIA-189A colours, and give both pixels of a pair the pair's chroma.
+ */
+enum kl_colorbar_format {
+	/** 8-bit 4:2:2 packed Cb Y Cr Y, as KL_COLORBAR_8BIT **/
+	KL_COLORBAR_FORMAT_UYVY = KL_COLORBAR_8BIT,
+	/** 10-bit 4:2:2 packed, as KL_COLORBAR_10BIT **/
+	KL_COLORBAR_FORMAT_V210 = KL_COLORBAR_10BIT,
+	/** 16-bit 4:2:2 packed Cb Y Cr Y **/
+	KL_COLORBAR_FORMAT_UYVY16,
+	/** 8-bit 4:2:0, a Y plane and an interleaved Cb Cr plane **/
+	KL_COLORBAR_FORMAT_NV12,
+	/** 8-bit 4:2:0, Y, Cb and Cr planes **/
+	KL_COLORBAR_FORMAT_I420,
+	/** 16-bit 4:2:0, a Y plane and an interleaved Cb Cr plane **/
+	KL_COLORBAR_FORMAT_P010,
+	/** 16-bit 4:2:2, a Y plane and an interleaved Cb Cr plane **/
+	KL_COLORBAR_FORMAT_P216,
+	/** 8-bit full range RGB, bytes B G R A with A always 255 **/
+	KL_COLORBAR_FORMAT_BGRA,
+	/** 10-bit RGB with video levels (64-940), a big endian word of 2 unused bits then R G B per pixel **/
+	KL_COLORBAR_FORMAT_R210,
+	/** 12-bit full range RGB, 8 pixels of R G B packed from bit 0 up into 9 big endian words **/
+	KL_COLORBAR_FORMAT_R12B,
+};
+
+#define KL_COLORBAR_MAX_PLANES 3
+
+/**
+ * @brief       Where kl_colorbar_finalize_planes() writes each plane of the output.  Planes are in the
+ *              order given for each format, and unused ones are ignored.
+ */
+struct kl_colorbar_planes
+{
+    enum kl_colorbar_format format;
+    unsigned char *data[KL_COLORBAR_MAX_PLANES]; /* Top left of each plane */
+    unsigned int stride[KL_COLORBAR_MAX_PLANES]; /* Bytes between rows of each plane */
+};
+
+/**
+ * @brief       As kl_colorbar_finalize(), but converting to any of the formats in enum kl_colorbar_format,
+ *              in a single pass over the frame.  4:2:0 chroma is the average of each pair of lines.
+ *              UYVY and V210 go through kl_colorbar_finalize(), the other formats always write the
+ *              whole frame.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   const struct kl_colorbar_planes *out - Output format and planes.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_finalize_planes(struct kl_colorbar_context *ctx,
+				const struct kl_colorbar_planes *out);
+
 /**
  * @brief       Free any internal allocations containined within the context, but note that this DOES NOT
  *              free the context itself. The context is user allocated and user destroyed. The context is no longer
@@ -72,6 +215,45 @@ int kl_colorbar_finalize(struct kl_colorbar_context *ctx, unsigned char *buf,
  */
 void kl_colorbar_free(struct kl_colorbar_context *ctx);
 
+/**
+ * @brief       Enable or disable tracking of which rows changed since the last finalize.
+ *              With tracking on, refilling the same pattern only restores the rows that text was
+ *              drawn over, and kl_colorbar_finalize() only converts and copies the rows that changed,
+ *              as long as it is given the same buf, stride and colorspace as on the previous call.
+ *              The caller must then guarantee that buffer still holds the previously finalized frame.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   int enable - Non-zero to enable tracking.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_set_dirty_tracking(struct kl_colorbar_context *ctx, int enable);
+
+/**
+ * @brief       Enable or disable use of the process wide pattern cache.
+ *              Each pattern is then rendered only once per width, height and bit depth, and shared
+ *              read-only between all contexts using the cache.  A context only allocates a frame of
+ *              its own once text is drawn over the pattern, so outputs without text overlays hold
+ *              no frame memory at all.  Safe to use from contexts on different threads.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   int enable - Non-zero to use the cache.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_set_pattern_cache(struct kl_colorbar_context *ctx, int enable);
+
+/**
+ * @brief       Spread pattern fills and kl_colorbar_finalize() over several threads.
+ *              The rows of the frame are split into bands which a pool of worker threads, kept
+ *              for the life of the context, and the calling thread work through together.  The
+ *              output is identical to that of a single thread.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   unsigned int threads - Total threads to use, counting the caller's.  0 or 1 goes
+ *              back to doing everything on the calling thread.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_set_threads(struct kl_colorbar_context *ctx, unsigned int threads);
+
 /**
  * @brief       Reset / re-initialize any internal position mechanisms related to string compositing.
  *              Generally you should do this at the beginning of every frame, before you render strings.
@@ -88,9 +270,14 @@ enum kl_colorbar_pattern {
 	KL_COLORBAR_EIA_189A,
 	/* SMPTE RP 198 Checkfield for HD Interfaces (i.e. "half pathological") */
 	KL_COLORBAR_SMPTE_RP_198,
+	/** Completely white (100%) video frame, the flash of kl_colorbar_fill_avsync() **/
+	KL_COLORBAR_WHITE,
+	/** First id handed out by kl_colorbar_load_pattern() **/
+	KL_COLORBAR_USER_PATTERN = 0x100,
 };
 /**
  * @brief       Composite the string 's' of length into the colorbar at position x, y, where 0,0 is top left.
+ *              Nothing is drawn, and an error returned, if the string would run off the frame.
  * @param[in]   struct kl_colorbar_context *ctx - Context.
  * @param[in]   char *s - ASCII string.
  * @param[in]   unsigned int len - length of string in bytes, maximum 128 bytes.
@@ -101,6 +288,54 @@ enum kl_colorbar_pattern {
  */
 int kl_colorbar_render_string(struct kl_colorbar_context *ctx, char *s, unsigned int len, unsigned int x, unsigned int y);
 
+/**
+ * @brief       Set the opacity of the background box drawn behind each character, so the pattern
+ *              underneath can still be judged through it.  The characters themselves are always
+ *              drawn solid.  Applies to kl_colorbar_render_string() and counters drawn from then on.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   unsigned int alpha - From 0 (no background at all) to 255 (solid, the default).
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_set_text_background(struct kl_colorbar_context *ctx, unsigned int alpha);
+
+enum kl_colorbar_counter {
+	/** Frame number, as counted by kl_colorbar_finalize(), zero padded to 8 digits **/
+	KL_COLORBAR_COUNTER_FRAMES,
+	/** SMPTE timecode HH:MM:SS:FF, or HH:MM:SS;FF for drop frame rates **/
+	KL_COLORBAR_COUNTER_TIMECODE,
+};
+
+/**
+ * @brief       Burn a running frame number or timecode into every frame, at text position x, y.
+ *              The value is taken from the number of frames finalized so far, and drawn by
+ *              kl_colorbar_finalize(), so there is no need to render it each frame.  With dirty
+ *              tracking enabled, only the characters which changed since the previous frame are
+ *              redrawn, and pattern fills leave the rows holding the counter alone.
+ *              Timecode rates of 30000/1001 and 60000/1001 count in drop frame, other rates are
+ *              counted at the nearest whole number of frames per second (so 24000/1001 counts as 24).
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   enum kl_colorbar_counter type - What to show.
+ * @param[in]   unsigned int x - Horizontal position, as for kl_colorbar_render_string()
+ * @param[in]   unsigned int y - Vertical position, as for kl_colorbar_render_string()
+ * @param[in]   unsigned int fps_num - Frame rate numerator, timecode only (e.g. 30000).
+ * @param[in]   unsigned int fps_den - Frame rate denominator, timecode only (e.g. 1001).
+ * @return      >= 0 - Index of the counter
+ * @return      < 0 - Error
+ */
+int kl_colorbar_add_counter(struct kl_colorbar_context *ctx,
+			    enum kl_colorbar_counter type, unsigned int x,
+			    unsigned int y, unsigned int fps_num, unsigned int fps_den);
+
+/**
+ * @brief       Stop burning in the counters added with kl_colorbar_add_counter().  What was drawn
+ *              last stays in the frame until the next kl_colorbar_fill_pattern().
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_remove_counters(struct kl_colorbar_context *ctx);
+
 /**
  * @brief       Fill colorbar with a pattern (e.g. EIA-189 colorbars, black video, etc)
  * @param[in]   kl_colorbar_context *ctx - Context.
@@ -120,6 +355,162 @@ void kl_colorbar_fill_colorbars(struct kl_colorbar_context *ctx);
  */
 void kl_colorbar_fill_black(struct kl_colorbar_context *ctx);
 
+/**
+ * @brief       A frame rendered by the frame pool, see kl_colorbar_frame_pool_start().
+ */
+struct kl_colorbar_frame
+{
+    struct kl_colorbar_planes planes; /* The frame, in the pool's format */
+    unsigned int pic_count; /* Its frame number, the context's pic_count when it was rendered */
+};
+
+/**
+ * @brief       Frame pool counters, see kl_colorbar_frame_pool_get_stats().
+ */
+struct kl_colorbar_frame_pool_stats
+{
+    unsigned int frames; /* In the pool */
+    unsigned int depth; /* Rendered and waiting to be taken */
+    unsigned long long rendered;
+    unsigned long long delivered; /* Taken with kl_colorbar_frame_pool_get() */
+    unsigned long long underruns; /* Calls to kl_colorbar_frame_pool_get() that found no frame ready */
+    unsigned long long errors; /* Frames that failed to render, which are not handed out */
+};
+
+/**
+ * @brief       Called by the frame pool's thread for every frame, after the pattern fill and
+ *              before finalize, to draw whatever changes from frame to frame.
+ */
+typedef void (*kl_colorbar_frame_fn)(struct kl_colorbar_context *ctx, void *priv);
+
+/**
+ * @brief       Start rendering frames ahead of time, on a thread of the context's own.  The thread
+ *              keeps every free frame of the pool rendered, filling it with the pattern, calling
+ *              render and finalizing it (counters included) into the given format.  Until
+ *              kl_colorbar_frame_pool_stop() the thread owns the context, and no other call may be
+ *              made with it apart from the kl_colorbar_frame_pool functions.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   unsigned int frames - Number of frames in the pool, 1 to 64.
+ * @param[in]   enum kl_colorbar_format format - Output format.
+ * @param[in]   enum kl_colorbar_pattern pattern - Pattern every frame is filled with, which must
+ *              exist when the pool is started.
+ * @param[in]   kl_colorbar_frame_fn render - Called for every frame, may be NULL.
+ * @param[in]   void *priv - Passed to render.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_frame_pool_start(struct kl_colorbar_context *ctx, unsigned int frames,
+				 enum kl_colorbar_format format,
+				 enum kl_colorbar_pattern pattern,
+				 kl_colorbar_frame_fn render, void *priv);
+
+/**
+ * @brief       Take the oldest rendered frame.  This never blocks, and may be called from any thread.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @return      The frame, to be handed back with kl_colorbar_frame_pool_put() once done with,
+ *              or NULL if none was ready (counted as an underrun).
+ */
+struct kl_colorbar_frame *kl_colorbar_frame_pool_get(struct kl_colorbar_context *ctx);
+
+/**
+ * @brief       Hand a frame back to be rendered again.  This never blocks, and may be called from
+ *              any thread, but each frame only once per kl_colorbar_frame_pool_get().
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   struct kl_colorbar_frame *frame - Frame from kl_colorbar_frame_pool_get().
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_frame_pool_put(struct kl_colorbar_context *ctx, struct kl_colorbar_frame *frame);
+
+/**
+ * @brief       Read the frame pool's queue depth and counters.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[out]  struct kl_colorbar_frame_pool_stats *stats - Filled in.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_frame_pool_get_stats(struct kl_colorbar_context *ctx,
+				     struct kl_colorbar_frame_pool_stats *stats);
+
+/**
+ * @brief       Stop the frame pool's thread and free its frames, including any not yet handed
+ *              back.  kl_colorbar_free() does this too.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_frame_pool_stop(struct kl_colorbar_context *ctx);
+
+/**
+ * @brief       A clock for kl_colorbar_pace(), in nanoseconds.  Lets pacing run against a mock
+ *              clock, for testing it offline.
+ */
+struct kl_colorbar_clock
+{
+    unsigned long long (*now)(void *priv);
+    void (*sleep_until)(unsigned long long time, void *priv); /* Returns at once if time has passed */
+    void *priv;
+};
+
+#define KL_COLORBAR_JITTER_BINS 24
+
+/**
+ * @brief       Delivery statistics of kl_colorbar_pace().  Jitter is how long after its time a frame
+ *              went out.
+ */
+struct kl_colorbar_pacing_stats
+{
+    unsigned long long frames; /* Delivered */
+    unsigned long long late; /* Delivered a frame period or more after their time */
+    unsigned long long dropped; /* Due when the frame pool had none ready, and skipped */
+    unsigned long long max_jitter_ns;
+    unsigned long long jitter[KL_COLORBAR_JITTER_BINS]; /* Bin 0 counts jitter under 1us, bin i from 2^(i-1) up to 2^i us, the last anything above */
+};
+
+/**
+ * @brief       Called by kl_colorbar_pace() with each frame at its time.
+ * @param[in]   const struct kl_colorbar_frame *frame - Only valid until the callback returns.
+ * @param[in]   unsigned long long time - When the frame was due, on the pacing clock.
+ * @param[in]   void *priv - From struct kl_colorbar_pacing.
+ * @return      0 to carry on, anything else to stop.
+ */
+typedef int (*kl_colorbar_deliver_fn)(const struct kl_colorbar_frame *frame, unsigned long long time,
+				      void *priv);
+
+/**
+ * @brief       What kl_colorbar_pace() delivers, and how often.
+ */
+struct kl_colorbar_pacing
+{
+    unsigned int fps_num; /* Frame rate as a fraction, e.g. 30000/1001 */
+    unsigned int fps_den;
+    enum kl_colorbar_format format; /* These three are ignored while the frame pool is running */
+    enum kl_colorbar_pattern pattern;
+    kl_colorbar_frame_fn render; /* May be NULL */
+    kl_colorbar_deliver_fn deliver;
+    void *priv; /* Passed to render and deliver */
+    const struct kl_colorbar_clock *clock; /* NULL for CLOCK_MONOTONIC */
+    unsigned long long frames; /* How many frame times to run for, 0 for no limit */
+};
+
+/**
+ * @brief       Deliver frames at a fixed frame rate, in the calling thread, for the given number of
+ *              frame times or until deliver asks to stop.  Frame n is due (n + 1) frame periods after
+ *              the call, each time worked out exactly from the rational rate, so 1000/1001 rates
+ *              keep their cadence for good.  Frames are rendered ahead of their time, or taken from
+ *              the frame pool when it is running.  A late frame isn't dropped; the frames after it
+ *              go out as soon as they can until the schedule is caught up.  The exception is a
+ *              frame due when the frame pool has none ready, which is skipped and counted as
+ *              dropped.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   const struct kl_colorbar_pacing *pacing - Rate, frames and callbacks.
+ * @param[out]  struct kl_colorbar_pacing_stats *stats - Filled in.
+ * @return      0 - Success
+ * @return      < 0 - Error, including the frame pool having had no frame ready for a second
+ */
+int kl_colorbar_pace(struct kl_colorbar_context *ctx, const struct kl_colorbar_pacing *pacing,
+		     struct kl_colorbar_pacing_stats *stats);
+
 /**
  * @brief       Retrieve name of named pattern.
  *              This allows an application to get a textual representation
@@ -131,10 +522,109 @@ void kl_colorbar_fill_black(struct kl_colorbar_context *ctx);
 const char *kl_colorbar_get_pattern_name(struct kl_colorbar_context *ctx,
 					 enum kl_colorbar_pattern pattern);
 
+/**
+ * @brief       Load a pattern description from a text file, for use with kl_colorbar_fill_pattern().
+ *              The file describes horizontal bands, each made up of solid or ramped spans:
+ *
+ *                  name My bars
+ *                  band 3/4
+ *                  solid 1/2 721 512 512
+ *                  ramp 1/2 64 512 512 940 512 512
+ *                  band 1/4
+ *                  solid 1 64 512 512
+ *
+ *              Band heights and span widths are fractions of the frame, and colours are 10-bit
+ *              Y, Cb and Cr (a ramp gives the colour at its left and then its right edge).  The
+ *              last band and span always extend to the edge of the frame.  Loaded patterns
+ *              stay available, to every context, for the life of the process.
+ * @param[in]   const char *filename - Pattern description file.
+ * @return      Pattern id, KL_COLORBAR_USER_PATTERN or above
+ * @return      < 0 - Error, including a malformed description
+ */
+int kl_colorbar_load_pattern(const char *filename);
 
 /**
- * @brief       TODO: Document..... Generate an audio tone which can be pushed out on a PCM channel.
- * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @brief       As kl_colorbar_load_pattern(), but from a description held in memory.
+ * @param[in]   const char *text - Pattern description, NUL terminated.
+ * @return      Pattern id, KL_COLORBAR_USER_PATTERN or above
+ * @return      < 0 - Error
+ */
+int kl_colorbar_parse_pattern(const char *text);
+
+
+/**
+ * @brief       Instruction set levels the pixel kernels can be built for.
+ */
+enum kl_colorbar_cpu_level {
+	/** Plain C reference kernels **/
+	KL_COLORBAR_CPU_SCALAR = 0,
+	KL_COLORBAR_CPU_SSE2,
+	KL_COLORBAR_CPU_SSSE3,
+	KL_COLORBAR_CPU_AVX2,
+};
+
+/**
+ * @brief       Force the pixel kernels to a given instruction set level, for A/B testing.
+ *              The kernels are normally picked automatically from cpuid the first time a
+ *              context is initialized, optionally capped by the KLBARS_CPU_LEVEL environment
+ *              variable ("scalar", "sse2", "ssse3" or "avx2").  The selection is process
+ *              wide, so this should not be called while other threads are rendering.
+ * @param[in]   enum kl_colorbar_cpu_level level - Level to use.
+ * @return      0 - Success
+ * @return      < 0 - Error, the level is not supported by this CPU
+ */
+int kl_colorbar_set_cpu_level(enum kl_colorbar_cpu_level level);
+
+/**
+ * @brief       Retrieve the instruction set level currently in use.
+ */
+enum kl_colorbar_cpu_level kl_colorbar_get_cpu_level(void);
+
+/**
+ * @brief       Retrieve the name of an internal pixel kernel.
+ *              Typically the application would use a loop to get the names
+ *              of all the kernels (i.e. increment kernel until NULL is returned).
+ * @param[in]   int kernel - Kernel index, starting at 0.
+ */
+const char *kl_colorbar_get_kernel_name(int kernel);
+
+/**
+ * @brief       Retrieve which implementation (e.g. "scalar", "avx2") was selected for a kernel.
+ * @param[in]   int kernel - Kernel index, starting at 0.
+ * @return      NULL if kernel is out of range.
+ */
+const char *kl_colorbar_get_kernel_impl(int kernel);
+
+/**
+ * @brief       Generate an audio tone which can be pushed out on a PCM channel, the same sample
+ *              on every channel.  Only whole periods of the tone are kept (rate / gcd(freq, rate)
+ *              samples, repeated up to a few thousand or a tenth of a second, whichever is more),
+ *              so memory doesn't depend on how long it plays and it loops without a click.  The
+ *              loop holds a whole frame of audio at any frame rate of 10fps or more.
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context, initialized by this call.
+ * @param[in]   int toneFreqHz - Tone frequency.
+ * @param[in]   enum kl_colorbar_sample_format format - Sample format.
+ * @param[in]   unsigned int flags - KL_COLORBAR_AUDIO_PLANAR and KL_COLORBAR_AUDIO_BIG_ENDIAN, or 0
+ *              for interleaved little endian samples.
+ * @param[in]   int channelCount - Number of channels.
+ * @param[in]   int sampleRate - Samples per second, up to 16777216.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tonegenerator_create(struct kl_colorbar_audio_context *audio_ctx,
+				     int toneFreqHz, enum kl_colorbar_sample_format format,
+				     unsigned int flags, int channelCount, int sampleRate);
+
+/**
+ * @brief       As kl_colorbar_tonegenerator_create(), for interleaved 8- or 16-bit samples in the
+ *              machine's own byte order.
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context, initialized by this call.
+ * @param[in]   int toneFreqHz - Tone frequency.
+ * @param[in]   int sampleSize - 8 or 16 bits.
+ * @param[in]   int channelCount - Interleaved channels.
+ * @param[in]   int durationUs - Unused, the tone plays for as long as it is extracted.
+ * @param[in]   int sampleRate - Samples per second.
+ * @param[in]   int signedSample - Nonzero for signed samples.
  * @return      0 - Success
  * @return      < 0 - Error
  */
@@ -144,13 +634,407 @@ int kl_colorbar_tonegenerator(struct kl_colorbar_audio_context *audio_ctx,
 			      int sampleRate, int signedSample);
 
 /**
- * @brief       TODO: Document.....
- * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @brief       Copy the next bufSize bytes of an interleaved tone, carrying on from where the last
+ *              call left off.  Planar tones are left alone, see
+ *              kl_colorbar_tonegenerator_extract_planar().
  * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context
+ * @param[out]  unsigned char *buf - Destination.
+ * @param[in]   size_t bufSize - Bytes to copy, any amount.
  */
 void kl_colorbar_tonegenerator_extract(struct kl_colorbar_audio_context *audio_ctx,
 				       unsigned char *buf, size_t bufSize);
 
+/**
+ * @brief       Copy the next sampleCount samples of every channel of a planar tone.
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context
+ * @param[out]  unsigned char **planes - One destination per channel.
+ * @param[in]   size_t sampleCount - Samples per channel, any amount.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tonegenerator_extract_planar(struct kl_colorbar_audio_context *audio_ctx,
+					     unsigned char **planes, size_t sampleCount);
+
+/**
+ * @brief       A piece of a tone's own memory, see kl_colorbar_tonegenerator_peek().
+ */
+struct kl_colorbar_audio_span
+{
+	const unsigned char *data;
+	size_t size;
+};
+
+/**
+ * @brief       A read position in a tone.  Any number of them can read one tone independently; a
+ *              zeroed cursor starts at the beginning.
+ */
+struct kl_colorbar_audio_cursor
+{
+	size_t location; /* Bytes into the interleaved data, or into every plane */
+};
+
+/**
+ * @brief       Point at the next bytes of the tone without copying them, as one span or, where they
+ *              wrap round, two.  Nothing moves until kl_colorbar_tonegenerator_advance().  For a
+ *              planar tone the spans are in the first channel's plane, and channel c is
+ *              c * samples * sample_bytes further on.  At most one loop of the tone (all of
+ *              audio_data_size, or a plane) is returned at once, so the spans may add up to less
+ *              than was asked for.
+ * @param[in]   const struct kl_colorbar_audio_context *audio_ctx - Context
+ * @param[in]   const struct kl_colorbar_audio_cursor *cursor - Read position, or NULL for the
+ *              context's own, the one extract uses.
+ * @param[in]   size_t bytes - Bytes wanted, per plane for a planar tone.
+ * @param[out]  struct kl_colorbar_audio_span *spans - Two spans, filled in.
+ * @return      Number of spans filled in, 1 or 2
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tonegenerator_peek(const struct kl_colorbar_audio_context *audio_ctx,
+				   const struct kl_colorbar_audio_cursor *cursor, size_t bytes,
+				   struct kl_colorbar_audio_span *spans);
+
+/**
+ * @brief       Move a read position on, once the bytes from kl_colorbar_tonegenerator_peek() have
+ *              been used.
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context
+ * @param[in]   struct kl_colorbar_audio_cursor *cursor - Read position, or NULL for the context's own.
+ * @param[in]   size_t bytes - Bytes to move on by, per plane for a planar tone.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tonegenerator_advance(struct kl_colorbar_audio_context *audio_ctx,
+				      struct kl_colorbar_audio_cursor *cursor, size_t bytes);
+
+#define KL_COLORBAR_CADENCE_MAX 256
+
+/**
+ * @brief       Audio samples per video frame, see kl_colorbar_audio_cadence_init().
+ */
+struct kl_colorbar_audio_cadence
+{
+	unsigned int frames; /* In one cycle of the cadence */
+	unsigned int cycle_samples;
+	unsigned int count[KL_COLORBAR_CADENCE_MAX]; /* Samples in each frame of the cycle */
+	unsigned int first[KL_COLORBAR_CADENCE_MAX]; /* First sample of each, from the start of the cycle */
+
+	/* Where the last frame looked up ended, so the next one needs no division */
+	const struct kl_colorbar_audio_context *tone;
+	unsigned long long next_frame;
+	unsigned int next_index;
+	size_t next_location;
+};
+
+/**
+ * @brief       Work out how many audio samples go with each video frame.  The first sample of frame
+ *              n is n * sampleRate / frame rate, rounded to nearest, which at 48kHz gives
+ *              1602 1601 1602 1601 1602 for 30000/1001 and 801 801 800 801 801 for 60000/1001.
+ *              The counts for one whole cycle are kept, so frame lookups don't drift however long
+ *              they run.
+ * @param[out]  struct kl_colorbar_audio_cadence *cadence - Initialized by this call.
+ * @param[in]   unsigned int sampleRate - Samples per second.
+ * @param[in]   unsigned int fps_num - Frame rate as a fraction, e.g. 30000/1001.
+ * @param[in]   unsigned int fps_den
+ * @return      0 - Success
+ * @return      < 0 - Error, including a cycle longer than KL_COLORBAR_CADENCE_MAX frames
+ */
+int kl_colorbar_audio_cadence_init(struct kl_colorbar_audio_cadence *cadence,
+				   unsigned int sampleRate, unsigned int fps_num,
+				   unsigned int fps_den);
+
+/**
+ * @brief       Point at the audio of video frame n (e.g. the context's pic_count), without copying
+ *              it, as kl_colorbar_tonegenerator_peek() does.  Frame 0 starts at the start of the
+ *              tone.  Asking for the frames in order is cheapest.  No read position moves.
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context, whose loop must hold at
+ *              least a frame of samples, as it does at 10fps or more.
+ * @param[in]   struct kl_colorbar_audio_cadence *cadence - Cadence, used with one thread at a time.
+ * @param[in]   unsigned long long frame - Frame number.
+ * @param[out]  struct kl_colorbar_audio_span *spans - Two spans, filled in.
+ * @param[out]  unsigned int *sampleCount - Samples in the frame.
+ * @return      Number of spans filled in, 1 or 2
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tonegenerator_frame(struct kl_colorbar_audio_context *audio_ctx,
+				    struct kl_colorbar_audio_cadence *cadence,
+				    unsigned long long frame, struct kl_colorbar_audio_span *spans,
+				    unsigned int *sampleCount);
+
+/**
+ * @brief       Copy the audio of video frame n of an interleaved tone, see
+ *              kl_colorbar_tonegenerator_frame().  Frames longer than the tone's loop are
+ *              copied too, going round it as many times as they need.
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context
+ * @param[in]   struct kl_colorbar_audio_cadence *cadence - Cadence.
+ * @param[in]   unsigned long long frame - Frame number.
+ * @param[out]  unsigned char *buf - Destination, with room for the largest count in the cadence.
+ * @return      Samples copied
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tonegenerator_extract_frame(struct kl_colorbar_audio_context *audio_ctx,
+					    struct kl_colorbar_audio_cadence *cadence,
+					    unsigned long long frame, unsigned char *buf);
+
+#define KL_COLORBAR_TONE_MAX_CHANNELS 64
+
+/**
+ * @brief       What one channel of kl_colorbar_tonegenerator_multi() plays.
+ */
+struct kl_colorbar_tone_spec
+{
+	int freq_hz; /* 0 for silence */
+	double level_dbfs; /* Peak level, 0 for full scale and no higher */
+	unsigned int cycle_ms; /* Length of the on/off cycle, 0 for a continuous tone */
+	unsigned int mute_start_ms; /* Silent from here in each cycle, */
+	unsigned int mute_ms; /* for this long */
+};
+
+/**
+ * @brief       Generate a tone with its own frequency, level and interruptions on every channel.
+ *              Each channel's period and on/off envelope is worked out once, and the tone holds
+ *              the shortest loop they all repeat in, so producing audio from it is still only a
+ *              copy (or no copy, see kl_colorbar_tonegenerator_peek()).
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context, initialized by this call.
+ * @param[in]   const struct kl_colorbar_tone_spec *specs - One per channel.
+ * @param[in]   int channelCount - Number of channels, up to KL_COLORBAR_TONE_MAX_CHANNELS.
+ * @param[in]   enum kl_colorbar_sample_format format - Sample format.
+ * @param[in]   unsigned int flags - As for kl_colorbar_tonegenerator_create().
+ * @param[in]   int sampleRate - Samples per second.  Cycle lengths must be a whole number of
+ *              samples at this rate.
+ * @return      0 - Success
+ * @return      < 0 - Error, including a loop of over a minute or a level above 0dBFS
+ */
+int kl_colorbar_tonegenerator_multi(struct kl_colorbar_audio_context *audio_ctx,
+				    const struct kl_colorbar_tone_spec *specs, int channelCount,
+				    enum kl_colorbar_sample_format format, unsigned int flags,
+				    int sampleRate);
+
+/**
+ * @brief       Fill in channel identification tones: continuous, at -18dBFS, and 400Hz on the first
+ *              channel going up 100Hz a channel, so swapped or missing channels show up on any
+ *              spectrum display.
+ * @param[out]  struct kl_colorbar_tone_spec *specs - One per channel.
+ * @param[in]   int channelCount - Number of channels, up to KL_COLORBAR_TONE_MAX_CHANNELS.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tone_specs_ident(struct kl_colorbar_tone_spec *specs, int channelCount);
+
+/**
+ * @brief       Fill in interrupted line-up tones in the style of EBU Tech 3304: 1kHz at -18dBFS on
+ *              every channel, with each channel silenced for 250ms in turn, first to last, followed
+ *              by 500ms of all channels together to mark the start of the next cycle.  The order the
+ *              gaps come in identifies the channels.
+ * @param[out]  struct kl_colorbar_tone_spec *specs - One per channel.
+ * @param[in]   int channelCount - Number of channels, up to KL_COLORBAR_TONE_MAX_CHANNELS.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tone_specs_ebu3304(struct kl_colorbar_tone_spec *specs, int channelCount);
+
+/**
+ * @brief       Draw frame n of the A/V sync test signal: a white frame once every period_frames
+ *              frames, starting with frame 0, and black otherwise.
+ * @param[in]   struct kl_colorbar_context *ctx - Context.
+ * @param[in]   unsigned int period_frames - Frames from one flash to the next.
+ * @param[in]   unsigned long long frame - Frame number.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_fill_avsync(struct kl_colorbar_context *ctx, unsigned int period_frames,
+			    unsigned long long frame);
+
+/**
+ * @brief       Generate the audio of the A/V sync test signal: a beep lasting the first frame of
+ *              every period_frames frames, and silence otherwise.  The tone holds exactly one
+ *              period, so with kl_colorbar_tonegenerator_frame() and the same cadence each beep
+ *              starts on the first sample of a flash frame from kl_colorbar_fill_avsync().  The beep
+ *              starts at its peak, so its first sample can be found exactly.
+ * @param[in]   struct kl_colorbar_audio_context *audio_ctx - Context, initialized by this call.
+ * @param[in]   const struct kl_colorbar_audio_cadence *cadence - Samples per frame.
+ * @param[in]   unsigned int period_frames - Frames from one beep to the next, a multiple of
+ *              the frames in the cadence's cycle.
+ * @param[in]   int toneFreqHz - Beep frequency.
+ * @param[in]   enum kl_colorbar_sample_format format - Sample format.
+ * @param[in]   unsigned int flags - As for kl_colorbar_tonegenerator_create().
+ * @param[in]   int channelCount - Number of channels, all beeping together.
+ * @param[in]   int sampleRate - Samples per second, the one the cadence was made for.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_tonegenerator_avsync(struct kl_colorbar_audio_context *audio_ctx,
+				     const struct kl_colorbar_audio_cadence *cadence,
+				     unsigned int period_frames, int toneFreqHz,
+				     enum kl_colorbar_sample_format format, unsigned int flags,
+				     int channelCount, int sampleRate);
+
+/**
+ * @brief       A/V offsets found by the analyzer, in samples.  Positive offsets are audio late.
+ */
+struct kl_colorbar_avsync_stats
+{
+	unsigned long long flashes;
+	unsigned long long beeps;
+	unsigned long long measurements; /* Flashes and beeps paired up */
+	long long offset; /* The last one */
+	long long min_offset;
+	long long max_offset;
+};
+
+/**
+ * @brief       Streaming analyzer for the A/V sync test signal coming back from a capture, see
+ *              kl_colorbar_avsync_analyzer_init().
+ */
+struct kl_colorbar_avsync_analyzer
+{
+	unsigned int width;
+	unsigned int height;
+	unsigned int stride;
+	int colorspace;
+	unsigned int sample_rate;
+	enum kl_colorbar_sample_format format;
+	int swap; /* Samples are in the other byte order to the machine's */
+	unsigned int channels;
+	unsigned int channel;
+	struct kl_colorbar_audio_cadence cadence;
+
+	/* Video side */
+	unsigned long long frame;
+	int lit;
+	long long flash; /* Sample the last unpaired flash was at, or -1 */
+
+	/* Audio side, measured in short windows */
+	unsigned long long sample;
+	int loud;
+	double energy;
+	unsigned int window;
+	long long first_peak;
+	long long prev_peak;
+	long long beep; /* Sample the last unpaired beep started at, or -1 */
+
+	struct kl_colorbar_avsync_stats stats;
+};
+
+/**
+ * @brief       Set up an analyzer.  Captured frames and audio are fed in separately, both from the
+ *              start of the capture, and every flash is paired with the beep nearest to it, within
+ *              half a second, to give the offset.
+ * @param[out]  struct kl_colorbar_avsync_analyzer *an - Initialized by this call.
+ * @param[in]   unsigned int width - Frame width.
+ * @param[in]   unsigned int height - Frame height.
+ * @param[in]   unsigned int stride - Bytes per line of the frames.
+ * @param[in]   int colorspace - KL_COLORBAR_8BIT for UYVY frames or KL_COLORBAR_10BIT for V210.
+ * @param[in]   unsigned int sampleRate - Samples per second.
+ * @param[in]   unsigned int fps_num - Frame rate as a fraction, e.g. 30000/1001.
+ * @param[in]   unsigned int fps_den
+ * @param[in]   enum kl_colorbar_sample_format format - S16, S24_32, S32 or FLOAT32, interleaved.
+ * @param[in]   unsigned int flags - KL_COLORBAR_AUDIO_BIG_ENDIAN, or 0 for little endian samples,
+ *              as given to the tone generator.  KL_COLORBAR_AUDIO_PLANAR is not supported.
+ * @param[in]   unsigned int channels - Channels in the audio.
+ * @param[in]   unsigned int channel - The one to listen to.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_avsync_analyzer_init(struct kl_colorbar_avsync_analyzer *an,
+				     unsigned int width, unsigned int height,
+				     unsigned int stride, int colorspace,
+				     unsigned int sampleRate, unsigned int fps_num,
+				     unsigned int fps_den, enum kl_colorbar_sample_format format,
+				     unsigned int flags, unsigned int channels, unsigned int channel);
+
+/**
+ * @brief       Feed the analyzer the next captured frame.
+ * @param[in]   struct kl_colorbar_avsync_analyzer *an - Analyzer.
+ * @param[in]   const unsigned char *frame - The frame.
+ * @return      1 if this completed a measurement, 0 if not
+ * @return      < 0 - Error
+ */
+int kl_colorbar_avsync_analyze_frame(struct kl_colorbar_avsync_analyzer *an,
+				     const unsigned char *frame);
+
+/**
+ * @brief       Feed the analyzer the next captured audio, any amount at a time.
+ * @param[in]   struct kl_colorbar_avsync_analyzer *an - Analyzer.
+ * @param[in]   const unsigned char *pcm - Interleaved samples.
+ * @param[in]   size_t sampleCount - Samples per channel.
+ * @return      Measurements this completed
+ * @return      < 0 - Error
+ */
+int kl_colorbar_avsync_analyze_audio(struct kl_colorbar_avsync_analyzer *an,
+				     const unsigned char *pcm, size_t sampleCount);
+
+#define KL_COLORBAR_VERIFY_MAX_REGIONS 128
+
+/**
+ * @brief       One bar of a pattern as measured by kl_colorbar_verify_frame().  Levels are 10-bit,
+ *              8-bit frames being scaled up to match.
+ */
+struct kl_colorbar_verify_region
+{
+	unsigned int x, y, width, height; /* Part of the bar measured, clear of its edges */
+	unsigned int band, bar; /* Which band of the pattern, and which bar across it */
+	double expect_y, expect_cb, expect_cr; /* Mean levels the pattern has there */
+	double error_y, error_cb, error_cr; /* Mean measured less expected, last frame */
+	int failed; /* An error was over the tolerance, last frame */
+};
+
+/**
+ * @brief       Checks captured frames against the pattern they should hold, see
+ *              kl_colorbar_verifier_init().
+ */
+struct kl_colorbar_verifier
+{
+	unsigned int width;
+	unsigned int height;
+	unsigned int stride;
+	int colorspace;
+	unsigned int tolerance;
+
+	unsigned int regions;
+	struct kl_colorbar_verify_region region[KL_COLORBAR_VERIFY_MAX_REGIONS];
+
+	unsigned int failed; /* Regions failed in the last frame */
+	unsigned long long frames;
+	unsigned long long failed_frames;
+
+	unsigned short *line; /* Scratch line of components */
+};
+
+/**
+ * @brief       Set up a verifier for frames of a given pattern, such as colorbars that have been
+ *              through a router or encoder and back.  Each bar is found where the pattern is drawn
+ *              at this width and height, and measured away from its edges, so soft transitions
+ *              don't count against it.  Text or counters burnt in over the pattern will fail the
+ *              bars they cover.
+ * @param[out]  struct kl_colorbar_verifier *v - Initialized by this call.
+ * @param[in]   unsigned int width - Frame width.
+ * @param[in]   unsigned int height - Frame height.
+ * @param[in]   unsigned int stride - Bytes per line of the frames.
+ * @param[in]   int colorspace - KL_COLORBAR_8BIT for UYVY frames or KL_COLORBAR_10BIT for V210.
+ * @param[in]   enum kl_colorbar_pattern pattern - Pattern the frames should hold, built in or loaded.
+ * @param[in]   unsigned int tolerance - Largest mean error of any component of a bar, in 10-bit
+ *              levels, that still passes.  0 for an exact digital path.
+ * @return      0 - Success
+ * @return      < 0 - Error
+ */
+int kl_colorbar_verifier_init(struct kl_colorbar_verifier *v, unsigned int width,
+			      unsigned int height, unsigned int stride, int colorspace,
+			      enum kl_colorbar_pattern pattern, unsigned int tolerance);
+
+/**
+ * @brief       Measure every bar of a captured frame.  The errors of each bar are left in
+ *              v->region[], with failed set on those over the tolerance.
+ * @param[in]   struct kl_colorbar_verifier *v - Verifier.
+ * @param[in]   const unsigned char *frame - The frame.
+ * @return      1 if every bar passed, 0 if any failed
+ * @return      < 0 - Error
+ */
+int kl_colorbar_verify_frame(struct kl_colorbar_verifier *v, const unsigned char *frame);
+
+/**
+ * @brief       Free the verifier's allocations.  The struct itself belongs to the caller.
+ * @param[in]   struct kl_colorbar_verifier *v - Verifier.
+ */
+void kl_colorbar_verifier_free(struct kl_colorbar_verifier *v);
+
 /**
  * @brief       Free any internal allocations containined within the context, but note that this DOES NOT
  *              free the context itself. The context is user allocated and user destroyed. The context is no longer
@@ -4,70 +4,683 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <libklbars/klbars.h>
-#include <sys/time.h>
+#include <time.h>
+#include <math.h>
+#include "klbars-internal.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
-#define NUM_ITERATIONS 7500
+#define NUM_CONVERT_ITERATIONS 200
+#define NUM_THREAD_ITERATIONS 100
+#define NUM_TONE_SECONDS 20
 
-int run_iteration(int width, int height, int indepth, int bitdepth)
+/* Cycle counter where the CPU has one, nanoseconds otherwise */
+static uint64_t read_cycles(void)
 {
-	struct kl_colorbar_context osd_ctx;
-	unsigned char *buf;
-	struct timeval start_time, end_time, delta_time;
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
 
-	/* Use the custom V210 stride required by the Decklink stack */
-	int rowWidth = ((width + 47) / 48) * 128;
+struct convert_kernel {
+	const char *name;
+	const char *isa;
+	kl_line_convert_fn fn;
+	int from10;
+};
+
+static const struct convert_kernel convert_kernels[] = {
+	{ "uyvy->v210", "scalar", kl_uyvy_to_v210_line_c, 0 },
+#if defined(__x86_64__) || defined(__i386__)
+	{ "uyvy->v210", "ssse3", kl_uyvy_to_v210_line_ssse3, 0 },
+	{ "uyvy->v210", "avx2", kl_uyvy_to_v210_line_avx2, 0 },
+#endif
+	{ "v210->uyvy", "scalar", kl_v210_to_uyvy_line_c, 1 },
+#if defined(__x86_64__) || defined(__i386__)
+	{ "v210->uyvy", "ssse3", kl_v210_to_uyvy_line_ssse3, 1 },
+	{ "v210->uyvy", "avx2", kl_v210_to_uyvy_line_avx2, 1 },
+#endif
+};
+
+static int cpu_has(const char *isa)
+{
+	enum kl_colorbar_cpu_level level = kl_colorbar_get_cpu_level();
+
+	if (strcmp(isa, "sse2") == 0)
+		return level >= KL_COLORBAR_CPU_SSE2;
+	if (strcmp(isa, "ssse3") == 0)
+		return level >= KL_COLORBAR_CPU_SSSE3;
+	if (strcmp(isa, "avx2") == 0)
+		return level >= KL_COLORBAR_CPU_AVX2;
+	return strcmp(isa, "scalar") == 0;
+}
+
+/* Compare the cycles-per-pixel of each finalize line converter.  Every
+   SIMD result is also checked against the scalar reference. */
+int run_convert_cycles(int width, int height)
+{
+	int stride = ((width + 47) / 48) * 128;
+	unsigned char *src = malloc(stride * height);
+	unsigned char *ref = malloc(stride * height);
+	unsigned char *dst = malloc(stride * height);
+	double scalar_cpp[2] = { 0, 0 };
+
+	for (int i = 0; i < stride * height; i++)
+		src[i] = rand();
+
+	printf("Finalize line converters at %dx%d, %d frames:\n", width,
+	       height, NUM_CONVERT_ITERATIONS);
+	for (int k = 0; k < sizeof(convert_kernels) / sizeof(convert_kernels[0]); k++) {
+		const struct convert_kernel *ck = &convert_kernels[k];
+		if (!cpu_has(ck->isa))
+			continue;
+
+		memset(ref, 0, stride * height);
+		memset(dst, 0, stride * height);
+		for (int y = 0; y < height; y++) {
+			(ck->from10 ? kl_v210_to_uyvy_line_c : kl_uyvy_to_v210_line_c)
+				(src + y * stride, ref + y * stride, width);
+			ck->fn(src + y * stride, dst + y * stride, width);
+		}
+
+		uint64_t start = read_cycles();
+		for (int i = 0; i < NUM_CONVERT_ITERATIONS; i++) {
+			for (int y = 0; y < height; y++)
+				ck->fn(src + y * stride, dst + y * stride, width);
+		}
+		uint64_t cycles = read_cycles() - start;
+
+		double cpp = (double)cycles / ((double)width * height * NUM_CONVERT_ITERATIONS);
+		if (scalar_cpp[ck->from10] == 0)
+			scalar_cpp[ck->from10] = cpp;
+		printf("  %s %-6s %7.3f cycles/pixel  %5.2fx  %s\n", ck->name, ck->isa,
+		       cpp, scalar_cpp[ck->from10] / cpp,
+		       memcmp(ref, dst, stride * height) == 0 ? "bit-exact" : "MISMATCH");
+	}
+
+	free(src);
+	free(ref);
+	free(dst);
+	return 0;
+}
 
-	buf = malloc(rowWidth * height);
-	memset(buf, 0, rowWidth * height);
-	kl_colorbar_init(&osd_ctx, width, height, indepth);
+static double now_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
 
-	printf("Generating %dx%d %d-bit colorbars (%d-bit internal) %d times...\n",
+/* Fill plus finalize time per frame with the work spread over 1, 2, 4
+   ... threads.  Each output is also compared against the single
+   threaded one. */
+int run_thread_scaling(int width, int height, int indepth, int bitdepth)
+{
+	int rowWidth = ((width + 47) / 48) * 128;
+	unsigned char *ref = calloc(rowWidth, height);
+	unsigned char *buf = calloc(rowWidth, height);
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	double single_ms = 0;
+
+	printf("Fill + finalize of %dx%d %d-bit colorbars (%d-bit internal), %d frames, %ld CPUs:\n",
 	       width, height, (bitdepth == KL_COLORBAR_10BIT ? 10 : 8),
-	       (indepth == KL_COLORBAR_10BIT ? 10 : 8), NUM_ITERATIONS);
-	gettimeofday(&start_time, NULL);
-	printf("Start time\t%ld.%06d\n", start_time.tv_sec, start_time.tv_usec);
-	for (int i = 0; i < NUM_ITERATIONS; i++) {
-		kl_colorbar_fill_colorbars(&osd_ctx);
-		char text[64];
-		snprintf(text, sizeof(text), "Hello World!\n");
-		kl_colorbar_render_string(&osd_ctx, text, strlen(text), 0, 2);
-		kl_colorbar_finalize(&osd_ctx, buf, bitdepth, rowWidth);
-	}
-	gettimeofday(&end_time, NULL);
-	printf("End time\t%ld.%06d\n", end_time.tv_sec, end_time.tv_usec);
-	timersub(&end_time, &start_time, &delta_time);
-	printf("Delta time\t%ld.%06d\n", delta_time.tv_sec, delta_time.tv_usec);
-
-	/* Compute FPS */
-	float fps = (float)NUM_ITERATIONS /
-	  ((float)delta_time.tv_sec * 1000 + (float)delta_time.tv_usec / 1000) * 1000;
-	printf("FPS=%f\n", fps);
+	       (indepth == KL_COLORBAR_10BIT ? 10 : 8), NUM_THREAD_ITERATIONS, cpus);
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		struct kl_colorbar_context osd_ctx;
 
-	kl_colorbar_free(&osd_ctx);
+		kl_colorbar_init(&osd_ctx, width, height, indepth);
+		kl_colorbar_set_threads(&osd_ctx, threads);
+
+		double start = now_ms();
+		for (int i = 0; i < NUM_THREAD_ITERATIONS; i++) {
+			kl_colorbar_fill_pattern(&osd_ctx, KL_COLORBAR_SMPTE_RP_219_1);
+			kl_colorbar_finalize(&osd_ctx, buf, bitdepth, rowWidth);
+		}
+		double ms = (now_ms() - start) / NUM_THREAD_ITERATIONS;
+
+		if (threads == 1) {
+			single_ms = ms;
+			memcpy(ref, buf, rowWidth * height);
+		}
+		printf("  %2d thread%s %8.3f ms/frame  %5.2fx  %s\n", threads,
+		       threads == 1 ? " " : "s", ms, single_ms / ms,
+		       memcmp(ref, buf, rowWidth * height) == 0 ? "identical" : "MISMATCH");
+		kl_colorbar_free(&osd_ctx);
+	}
+
+	free(ref);
 	free(buf);
 	return 0;
 }
 
-int main()
+/* Cost of taking a frame from the frame pool and handing it back, which
+   is all an output callback has left to do, against rendering it there */
+int run_frame_pool(int width, int height)
 {
-	/* 8-bit internal buffers */
-	run_iteration(640, 480, KL_COLORBAR_8BIT, KL_COLORBAR_8BIT);
-	run_iteration(640, 480, KL_COLORBAR_8BIT, KL_COLORBAR_10BIT);
+	struct kl_colorbar_context osd_ctx;
+	struct kl_colorbar_frame_pool_stats stats;
+	double handoff_ms = 0;
+	int frames = 0;
 
-	run_iteration(1280, 720, KL_COLORBAR_8BIT, KL_COLORBAR_8BIT);
-	run_iteration(1280, 720, KL_COLORBAR_8BIT, KL_COLORBAR_10BIT);
+	kl_colorbar_init(&osd_ctx, width, height, KL_COLORBAR_10BIT);
+	if (kl_colorbar_frame_pool_start(&osd_ctx, 4, KL_COLORBAR_FORMAT_V210,
+					 KL_COLORBAR_SMPTE_RP_219_1, NULL, NULL) < 0) {
+		kl_colorbar_free(&osd_ctx);
+		return -1;
+	}
 
-	run_iteration(1920, 1080, KL_COLORBAR_8BIT, KL_COLORBAR_8BIT);
-	run_iteration(1920, 1080, KL_COLORBAR_8BIT, KL_COLORBAR_10BIT);
+	while (frames < NUM_THREAD_ITERATIONS) {
+		double start = now_ms();
+		struct kl_colorbar_frame *frame = kl_colorbar_frame_pool_get(&osd_ctx);
 
-	/* 10-bit internal buffers */
-	run_iteration(640, 480, KL_COLORBAR_10BIT, KL_COLORBAR_8BIT);
-	run_iteration(640, 480, KL_COLORBAR_10BIT, KL_COLORBAR_10BIT);
+		if (frame == NULL) {
+			/* Give the producer a chance on a single CPU */
+			usleep(100);
+			continue;
+		}
+		kl_colorbar_frame_pool_put(&osd_ctx, frame);
+		handoff_ms += now_ms() - start;
+		frames++;
+	}
+	kl_colorbar_frame_pool_get_stats(&osd_ctx, &stats);
 
-	run_iteration(1280, 720, KL_COLORBAR_10BIT, KL_COLORBAR_8BIT);
-	run_iteration(1280, 720, KL_COLORBAR_10BIT, KL_COLORBAR_10BIT);
+	printf("Frame pool of %dx%d 10-bit colorbars: %.3f us/frame handoff, %llu rendered, %llu underruns\n",
+	       width, height, handoff_ms * 1000 / frames, stats.rendered, stats.underruns);
+	kl_colorbar_free(&osd_ctx);
+	return 0;
+}
+
+/* The tone synthesis the library had before, a libm sin() per sample
+   and the sample format worked out again for every one of them */
+static void tone_legacy(unsigned char *ptr, size_t samples, int toneFreqHz, int sampleSize,
+			int sampleRate, int signedSample)
+{
+	for (size_t sampleIndex = 0; sampleIndex < samples; sampleIndex++) {
+		double x = sin(2 * M_PI * toneFreqHz * (double)(sampleIndex % sampleRate) / sampleRate);
+
+		if (sampleSize == 8 && !signedSample) {
+			*ptr = (uint8_t)((1.0 + x) / 2 * 255);
+		} else if (sampleSize == 8 && signedSample) {
+			*ptr = (int8_t)(x * 127);
+		} else if (sampleSize == 16 && !signedSample) {
+			*(uint16_t *)ptr = ((1.0 + x) / 2 * 65535);
+		} else if (sampleSize == 16 && signedSample) {
+			*(int16_t *)ptr = (x * 32767);
+		}
+		ptr += sampleSize / 8;
+	}
+}
+
+/* Total harmonic distortion plus noise of a whole number of cycles, in
+   dB: whatever is left once the fundamental is projected out, against
+   the fundamental */
+static double thd_n(const float *wave, size_t samples, int toneFreqHz, int sampleRate)
+{
+	double a = 0, b = 0, total = 0, fundamental;
+
+	for (size_t i = 0; i < samples; i++) {
+		double x = 2 * M_PI * (double)((int64_t)toneFreqHz * i % sampleRate) / sampleRate;
+
+		a += wave[i] * sin(x);
+		b += wave[i] * cos(x);
+		total += (double)wave[i] * wave[i];
+	}
+	fundamental = 2 * (a * a + b * b) / samples;
+	return 10 * log10((total - fundamental) / fundamental);
+}
+
+/* Synthesis speed of the sine kernels against the old per sample
+   sin(), and how clean the tone they make is.  997Hz at 48kHz is one
+   second per period, so no sample lands on the same phase twice. */
+int run_tone_synthesis(void)
+{
+	const int freq = 997, rate = 48000;
+	const size_t samples = (size_t)NUM_TONE_SECONDS * rate;
+	const struct {
+		const char *isa;
+		kl_sine_fill_fn fn;
+	} kernels[] = {
+		{ "scalar", kl_sine_fill_c },
+#if defined(__x86_64__) || defined(__i386__)
+		{ "sse2", kl_sine_fill_sse2 },
+#endif
+	};
+	float *wave = malloc(samples * sizeof(float));
+	float *ref = malloc(rate * sizeof(float));
+	int16_t *pcm = malloc(samples * sizeof(int16_t));
+	double legacy_ms, ms;
+
+	if (wave == NULL || ref == NULL || pcm == NULL) {
+		free(wave);
+		free(ref);
+		free(pcm);
+		return -1;
+	}
+	kl_kernels_init();
+
+	legacy_ms = now_ms();
+	tone_legacy((unsigned char *)pcm, samples, freq, 16, rate, 1);
+	legacy_ms = now_ms() - legacy_ms;
+	printf("Tone synthesis %dHz S16, libm sin(): %.1f Msamples/s\n", freq,
+	       samples / legacy_ms / 1000);
 
-	run_iteration(1920, 1080, KL_COLORBAR_10BIT, KL_COLORBAR_8BIT);
-	run_iteration(1920, 1080, KL_COLORBAR_10BIT, KL_COLORBAR_10BIT);
+	for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+		if (!cpu_has(kernels[k].isa))
+			continue;
+		ms = now_ms();
+		for (size_t i = 0; i < samples; i += rate) {
+			kernels[k].fn(wave + i, rate, freq * 4, rate * 4, 0, 1.0f);
+			kl_kernels.tone_s16(wave + i, pcm + i, rate, 32767.0f, 0);
+		}
+		ms = now_ms() - ms;
+		printf("Tone synthesis %dHz S16, %-6s kernel: %.1f Msamples/s, %.1fx\n", freq,
+		       kernels[k].isa, samples / ms / 1000, legacy_ms / ms);
+	}
+
+	/* One period of each, compared in floats, and then as 16-bit */
+	for (int i = 0; i < rate; i++)
+		ref[i] = sin(2 * M_PI * (double)((int64_t)freq * i % rate) / rate);
+	kl_kernels.sine_fill(wave, rate, freq * 4, rate * 4, 0, 1.0f);
+	printf("Tone THD+N %dHz float: libm %.1f dB, kernel %.1f dB\n", freq,
+	       thd_n(ref, rate, freq, rate), thd_n(wave, rate, freq, rate));
+	for (int i = 0; i < rate; i++) {
+		ref[i] = (int16_t)(ref[i] * 32767.0f) / 32767.0f;
+		wave[i] = (int16_t)(wave[i] * 32767.0f) / 32767.0f;
+	}
+	printf("Tone THD+N %dHz S16:   libm %.1f dB, kernel %.1f dB\n", freq,
+	       thd_n(ref, rate, freq, rate), thd_n(wave, rate, freq, rate));
+
+	free(wave);
+	free(ref);
+	free(pcm);
+	return 0;
+}
+
+
+/* Stage benchmark: each pattern fill, the text overlay and every
+   finalize conversion timed call by call, after a warmup, and reported
+   as percentiles so that the odd slow frame shows up as well as the
+   typical one. */
+
+enum output_style {
+	OUTPUT_TEXT,
+	OUTPUT_JSON,
+	OUTPUT_CSV,
+};
+
+struct stage_options {
+	int width;
+	int height;
+	int depth;
+	int iterations;
+	int warmup;
+	unsigned int threads;
+	enum output_style output;
+};
+
+struct stage_result {
+	const char *stage;
+	char variant[64];
+	double mean_us;
+	double p50_us;
+	double p99_us;
+	double max_us;
+};
+
+static const struct {
+	enum kl_colorbar_format format;
+	const char *name;
+} stage_formats[] = {
+	{ KL_COLORBAR_FORMAT_UYVY, "UYVY" },
+	{ KL_COLORBAR_FORMAT_V210, "V210" },
+	{ KL_COLORBAR_FORMAT_UYVY16, "UYVY16" },
+	{ KL_COLORBAR_FORMAT_NV12, "NV12" },
+	{ KL_COLORBAR_FORMAT_I420, "I420" },
+	{ KL_COLORBAR_FORMAT_P010, "P010" },
+	{ KL_COLORBAR_FORMAT_P216, "P216" },
+	{ KL_COLORBAR_FORMAT_BGRA, "BGRA" },
+	{ KL_COLORBAR_FORMAT_R210, "r210" },
+	{ KL_COLORBAR_FORMAT_R12B, "R12B" },
+};
+
+static const char *cpu_level_names[] = { "scalar", "sse2", "ssse3", "avx2" };
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	const uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+/* Nearest rank percentile of sorted samples */
+static double percentile_us(const uint64_t *ns, int count, int pct)
+{
+	int rank = ((int64_t)count * pct + 99) / 100;
+
+	return ns[rank > 0 ? rank - 1 : 0] / 1000.0;
+}
+
+static void stage_summarize(struct stage_result *r, uint64_t *ns, int count)
+{
+	double total = 0;
+
+	qsort(ns, count, sizeof(*ns), cmp_u64);
+	for (int i = 0; i < count; i++)
+		total += ns[i];
+	r->mean_us = total / count / 1000;
+	r->p50_us = percentile_us(ns, count, 50);
+	r->p99_us = percentile_us(ns, count, 99);
+	r->max_us = ns[count - 1] / 1000.0;
+}
+
+enum stage_op {
+	STAGE_FILL,
+	STAGE_TEXT,
+	STAGE_FINALIZE,
+	STAGE_FRAME,
+};
+
+/* One timed call of a stage, its time left in ns.  Setup the stage
+   needs but isn't about, such as a fresh pattern under the text, stays
+   outside the clock. */
+static int stage_once(struct kl_colorbar_context *ctx, enum stage_op op, int arg,
+		      const struct kl_colorbar_planes *out, uint64_t *ns)
+{
+	char text[] = "Hello World!";
+	uint64_t start;
+	int ret = -1;
+
+	switch (op) {
+	case STAGE_FILL:
+		start = now_ns();
+		ret = kl_colorbar_fill_pattern(ctx, arg);
+		break;
+	case STAGE_TEXT:
+		if (kl_colorbar_fill_pattern(ctx, KL_COLORBAR_SMPTE_RP_219_1) < 0)
+			return -1;
+		start = now_ns();
+		ret = kl_colorbar_render_string(ctx, text, strlen(text), 0, 2);
+		break;
+	case STAGE_FINALIZE:
+		start = now_ns();
+		ret = kl_colorbar_finalize_planes(ctx, out);
+		break;
+	case STAGE_FRAME:
+		start = now_ns();
+		if (kl_colorbar_fill_pattern(ctx, KL_COLORBAR_SMPTE_RP_219_1) < 0 ||
+		    kl_colorbar_render_string(ctx, text, strlen(text), 0, 2) < 0)
+			return -1;
+		ret = kl_colorbar_finalize_planes(ctx, out);
+		break;
+	default:
+		return -1;
+	}
+	*ns = now_ns() - start;
+	return ret < 0 ? -1 : 0;
+}
+
+static int stage_run(const struct stage_options *opt, enum stage_op op, int arg,
+		     const struct kl_colorbar_planes *out, uint64_t *ns,
+		     struct stage_result *r)
+{
+	struct kl_colorbar_context ctx;
+	uint64_t unused;
+	int ret = 0;
+
+	if (kl_colorbar_init(&ctx, opt->width, opt->height, opt->depth) < 0)
+		return -1;
+	if (kl_colorbar_set_threads(&ctx, opt->threads) < 0 ||
+	    kl_colorbar_fill_pattern(&ctx, KL_COLORBAR_SMPTE_RP_219_1) < 0)
+		ret = -1;
+
+	/* A stage that failed would be timed doing nothing */
+	for (int i = 0; ret == 0 && i < opt->warmup; i++)
+		ret = stage_once(&ctx, op, arg, out, &unused);
+	for (int i = 0; ret == 0 && i < opt->iterations; i++)
+		ret = stage_once(&ctx, op, arg, out, &ns[i]);
+	if (ret == 0)
+		stage_summarize(r, ns, opt->iterations);
+
+	kl_colorbar_free(&ctx);
+	return ret;
+}
+
+static void stage_print(const struct stage_options *opt, const struct stage_result *r,
+			int count)
+{
+	const int depth = opt->depth == KL_COLORBAR_10BIT ? 10 : 8;
+	const char *cpu = cpu_level_names[kl_colorbar_get_cpu_level()];
+
+	switch (opt->output) {
+	case OUTPUT_TEXT:
+		printf("Stages of %dx%d %d-bit colorbars, %d iterations after %d warmup, "
+		       "%u thread(s), %s kernels:\n", opt->width, opt->height, depth,
+		       opt->iterations, opt->warmup, opt->threads ? opt->threads : 1, cpu);
+		printf("  %-10s %-26s %10s %10s %10s %10s\n", "stage", "variant",
+		       "mean us", "p50 us", "p99 us", "max us");
+		for (int i = 0; i < count; i++)
+			printf("  %-10s %-26s %10.1f %10.1f %10.1f %10.1f\n", r[i].stage,
+			       r[i].variant, r[i].mean_us, r[i].p50_us, r[i].p99_us, r[i].max_us);
+		break;
+	case OUTPUT_JSON:
+		printf("{\n  \"version\": \"%s\",\n  \"width\": %d,\n  \"height\": %d,\n"
+		       "  \"depth\": %d,\n  \"iterations\": %d,\n  \"warmup\": %d,\n"
+		       "  \"threads\": %u,\n  \"cpu_level\": \"%s\",\n  \"results\": [\n",
+		       VERSION, opt->width, opt->height, depth, opt->iterations, opt->warmup,
+		       opt->threads ? opt->threads : 1, cpu);
+		for (int i = 0; i < count; i++)
+			printf("    { \"stage\": \"%s\", \"variant\": \"%s\", \"mean_us\": %.3f, "
+			       "\"p50_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f }%s\n",
+			       r[i].stage, r[i].variant, r[i].mean_us, r[i].p50_us, r[i].p99_us,
+			       r[i].max_us, i + 1 < count ? "," : "");
+		printf("  ]\n}\n");
+		break;
+	case OUTPUT_CSV:
+		printf("version,width,height,depth,iterations,warmup,threads,cpu_level,"
+		       "stage,variant,mean_us,p50_us,p99_us,max_us\n");
+		for (int i = 0; i < count; i++)
+			printf("%s,%d,%d,%d,%d,%d,%u,%s,%s,\"%s\",%.3f,%.3f,%.3f,%.3f\n",
+			       VERSION, opt->width, opt->height, depth, opt->iterations,
+			       opt->warmup, opt->threads ? opt->threads : 1, cpu, r[i].stage,
+			       r[i].variant, r[i].mean_us, r[i].p50_us, r[i].p99_us, r[i].max_us);
+		break;
+	}
+}
+
+int run_stages(const struct stage_options *opt)
+{
+	const int nformats = sizeof(stage_formats) / sizeof(stage_formats[0]);
+	struct stage_result results[64];
+	struct kl_colorbar_context probe;
+	struct kl_colorbar_frame frame;
+	const struct kl_colorbar_planes *out = &frame.planes;
+	uint64_t *ns = malloc(opt->iterations * sizeof(*ns));
+	unsigned char *buf = NULL;
+	size_t size = 0;
+	int count = 0, ret = 0;
+
+	if (ns == NULL ||
+	    kl_colorbar_init(&probe, opt->width, opt->height, opt->depth) < 0) {
+		free(ns);
+		return -1;
+	}
+
+	/* Big enough for any format, each laid out as it really is (V210
+	   lines padded to 48 pixels, and so on) */
+	for (int f = 0; f < nformats; f++) {
+		size_t bytes = kl_frame_layout(&probe, stage_formats[f].format, NULL, NULL);
+
+		if (bytes > size)
+			size = bytes;
+	}
+	if (size)
+		buf = calloc(1, size);
+	if (buf == NULL) {
+		kl_colorbar_free(&probe);
+		free(ns);
+		return -1;
+	}
+	kl_frame_layout(&probe, KL_COLORBAR_FORMAT_UYVY, &frame, buf);
+
+	/* Every built in pattern, in enum order */
+	for (int p = 0; ret == 0 && kl_colorbar_get_pattern_name(&probe, p); p++) {
+		results[count].stage = "fill";
+		snprintf(results[count].variant, sizeof(results[count].variant), "%s",
+			 kl_colorbar_get_pattern_name(&probe, p));
+		ret = stage_run(opt, STAGE_FILL, p, out, ns, &results[count++]);
+	}
+
+	if (ret == 0) {
+		results[count].stage = "text";
+		snprintf(results[count].variant, sizeof(results[count].variant), "Hello World!");
+		ret = stage_run(opt, STAGE_TEXT, 0, out, ns, &results[count++]);
+	}
+
+	for (int f = 0; ret == 0 && f < nformats; f++) {
+		kl_frame_layout(&probe, stage_formats[f].format, &frame, buf);
+		results[count].stage = "finalize";
+		snprintf(results[count].variant, sizeof(results[count].variant), "%s",
+			 stage_formats[f].name);
+		ret = stage_run(opt, STAGE_FINALIZE, 0, out, ns, &results[count++]);
+	}
+
+	/* The whole frame, the way an output would make it */
+	if (ret == 0) {
+		const int v210 = opt->depth == KL_COLORBAR_10BIT;
+
+		kl_frame_layout(&probe, v210 ? KL_COLORBAR_FORMAT_V210 : KL_COLORBAR_FORMAT_UYVY,
+				&frame, buf);
+		results[count].stage = "frame";
+		snprintf(results[count].variant, sizeof(results[count].variant),
+			 "fill+text+finalize %s", v210 ? "V210" : "UYVY");
+		ret = stage_run(opt, STAGE_FRAME, 0, out, ns, &results[count++]);
+	}
+
+	if (ret == 0)
+		stage_print(opt, results, count);
+	else if (count > 0)
+		fprintf(stderr, "Stage %s, %s failed\n", results[count - 1].stage,
+			results[count - 1].variant);
+
+	kl_colorbar_free(&probe);
+	free(buf);
+	free(ns);
+	return ret;
+}
+
+static void usage(const char *progname)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  -r WIDTHxHEIGHT  Resolution of the stage benchmark (default 1920x1080)\n"
+		"  -d 8|10          Internal bit depth (default 10)\n"
+		"  -n ITERATIONS    Timed iterations of each stage (default 500)\n"
+		"  -w ITERATIONS    Untimed warmup iterations of each stage (default 20)\n"
+		"  -t THREADS       Threads for fills and finalize (default 1)\n"
+		"  -o text|json|csv Output of the stage benchmark (default text)\n"
+		"  -x               Also run the kernel, threading, frame pool and tone benchmarks\n"
+		"                   (text output only)\n",
+		progname);
+}
+
+int main(int argc, char **argv)
+{
+	struct stage_options opt = {
+		.width = 1920,
+		.height = 1080,
+		.depth = KL_COLORBAR_10BIT,
+		.iterations = 500,
+		.warmup = 20,
+		.threads = 1,
+		.output = OUTPUT_TEXT,
+	};
+	int extended = 0;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "r:d:n:w:t:o:xh")) != -1) {
+		switch (ch) {
+		case 'r':
+			if (sscanf(optarg, "%dx%d", &opt.width, &opt.height) != 2 ||
+			    opt.width <= 0 || opt.height <= 0) {
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'd':
+			if (atoi(optarg) != 8 && atoi(optarg) != 10) {
+				usage(argv[0]);
+				return 1;
+			}
+			opt.depth = atoi(optarg) == 10 ? KL_COLORBAR_10BIT : KL_COLORBAR_8BIT;
+			break;
+		case 'n':
+			opt.iterations = atoi(optarg);
+			break;
+		case 'w':
+			opt.warmup = atoi(optarg);
+			break;
+		case 't':
+			opt.threads = atoi(optarg);
+			break;
+		case 'o':
+			if (strcmp(optarg, "text") == 0)
+				opt.output = OUTPUT_TEXT;
+			else if (strcmp(optarg, "json") == 0)
+				opt.output = OUTPUT_JSON;
+			else if (strcmp(optarg, "csv") == 0)
+				opt.output = OUTPUT_CSV;
+			else {
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'x':
+			extended = 1;
+			break;
+		default:
+			usage(argv[0]);
+			return ch == 'h' ? 0 : 1;
+		}
+	}
+	if (opt.iterations <= 0 || opt.warmup < 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	/* Only the stage results go to stdout as JSON or CSV */
+	if (extended && opt.output == OUTPUT_TEXT) {
+		for (int i = 0; kl_colorbar_get_kernel_name(i); i++)
+			printf("Kernel %-28s %s\n", kl_colorbar_get_kernel_name(i),
+			       kl_colorbar_get_kernel_impl(i));
+
+		run_convert_cycles(1920, 1080);
+
+		run_thread_scaling(1920, 1080, KL_COLORBAR_10BIT, KL_COLORBAR_10BIT);
+		run_thread_scaling(3840, 2160, KL_COLORBAR_10BIT, KL_COLORBAR_10BIT);
+		run_thread_scaling(3840, 2160, KL_COLORBAR_10BIT, KL_COLORBAR_8BIT);
+		run_thread_scaling(7680, 4320, KL_COLORBAR_10BIT, KL_COLORBAR_10BIT);
+
+		run_frame_pool(1920, 1080);
+		run_frame_pool(3840, 2160);
+
+		run_tone_synthesis();
+	}
+
+	if (run_stages(&opt) < 0) {
+		fprintf(stderr, "Stage benchmark of %dx%d failed\n", opt.width, opt.height);
+		return 1;
+	}
 	return 0;
 }
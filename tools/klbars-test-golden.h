@@ -0,0 +1,846 @@
+/* Generated by klbars_test -g, from the scalar kernels */
+
+static const struct golden_frame golden_frames[] = {
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x6ecd10f7525f54afULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0xd072d6cfdf8faa13ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x112bb4bed6071ddcULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x5fae3ffd1d40454eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x7ca80268be597e65ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x5413d98d375cbcf7ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x4cb416a80f00c806ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x879d590bc42e6cbdULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x2c9e746bb54d3e94ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xfc75cf30a55c40b4ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x09f2da517c3f5794ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xfb2b9cf22af954a8ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xc1e0e338c0959e94ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x9d96859fa85708ffULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x68d600a8e596dc09ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0xb30e708cab65d04aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xdd79b756e7643fb7ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x6cbf64df3c13f300ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xc83c7676870c351fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xf2d6e6bfc2b90b6dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xe5560bd3bb61cc85ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0xb961986ea6d6e9acULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x2524c45462f79ea8ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x5fae3ffd1d40454eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x7ca80268be597e65ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x3cf05b4592a9fd53ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x21cb8eebd7f587f1ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xbbb969da00a45629ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x7515ae09869bf35aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x1b7eaf8fd0e36ba9ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x870d51d9ae15132eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x19fb5bce7d3bb1d1ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xdde1214d20874931ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x4b8b385e5824b2b0ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x205cf72ce22d879cULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xd0ce03dbf91b545dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x72f8be4147f6047eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x01bc5c0896fdc3beULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x3fbd842f4d04cba4ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x14aff6e68e354831ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x7b51b08af7fabbeaULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0xd7c503cae9f0bb8cULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x623e1a028b553f76ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xadefaeb261b5fd86ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0xfba2d79ac4fceb74ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0xfe38a06067d3bdc9ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x364b98fd5780b2c1ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xc798073ac69e39a4ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x196715f833a1b97fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x6f2d67c4117c79c3ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x0705c0148c15d56fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x99aabf7f2624f32dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xd54e855a7b8be09eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xcb8bda05037288c8ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x50e71dc1a8b72739ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x944467ad5ee324d1ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xef3cd2618d2f7c27ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x3847c1de8729937aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xd171e9621f763635ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x2ab63ec5e7a9b0fcULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x670d25c7dc1a0bf8ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0xedfb16c017ba6e38ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xb8d42832b1b5ccb9ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xadefaeb261b5fd86ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0xfba2d79ac4fceb74ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xe38436cfe663f539ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x7edd6181ffcadf03ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x6f57229c47e16715ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xea7db06b9a071fdeULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x369408cf50e4bd3dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x2d01797b215c0503ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x4f74c0f04684060cULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xda7b08569c858940ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xfcc192089608e3b8ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x3376aac8f98380bbULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x245f1c9bdb332d39ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x723a418b7ba6967dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x70738102767fda5eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x09661ce4ea622b31ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xed135ef7b6975faaULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xaa28efb82e755c3fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x1907dec7f65685dfULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xf295c6b855613a45ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x045f9a100b1ea9e4ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x5b4c93d6c492f774ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x48e401fcfad5862dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x3e1d50b8523708aeULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x21c21acd391fc9fbULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x5c44d7369c15e12aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x1a4fa57b0752fd80ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x6c4dcdbafd899dd7ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x850668094d5b088fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x7c0367565155b283ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x52bc4e32d532ab03ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xbb642d58b69c96a1ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x643e5a5d3f65cc10ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x2c724124f344846dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xf044d0ade0bf5fa9ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x49c06adce17dd028ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x741e1b60e401a395ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x31d1825e9cc8763cULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x160616f65c21421dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x444cf8de5acc2c83ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x045f9a100b1ea9e4ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x5b4c93d6c492f774ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xc6bd8a12da499e89ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0xf723ce0e3985762aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x799043e3afefd39aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xe837d9ea49c17f14ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x7c8bc4308bebe8cfULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x7a7ed5d2fbe58638ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x370e9cae42e2876aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x9298c9f8cb6dcb88ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x89c2a19c73316961ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0xe24884b239da1b88ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x91a4430bc1ce52d7ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x077d1b55365a8165ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x67886fddffc33638ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x7a0775ee301f1236ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x63ea47c131b5b213ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xf879f2ba63890ddeULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x9824f3cac8074d8cULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xaf23b278f9babfeeULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x073471bfbd4895ecULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0xf247b92ae666ca2aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x7d4abaef2168b4eeULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x9ffeb53298be1f5cULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xd05ff52b19ae8c89ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x9f7b44d0f20e4584ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x236e78ac8de99ae8ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x398e4825201a69ebULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x0a810a9bb4e7f840ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xda99c0171e4d605eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xd9c5ab59f655736fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x760d5ad57851d83cULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x4f655cb9914389d9ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x4aad1e4ab9fef84dULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xf4f2a12f0287022fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xcf22386b9c3db10bULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x0c6d97b822d11275ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x3cc5671f58de6d6fULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x277dd1c4aed03eddULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x00d4224666219437ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x073471bfbd4895ecULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0xf247b92ae666ca2aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xea5a0a762075b9caULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x945def8c46472194ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xe0e71880c50ac81eULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xfd452e351bac6a10ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xdc3a0a888196f3dbULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xc317081f8b767f11ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0xe6273672460c232bULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xfe01adbcaa76feddULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xb9d9d61b61ca95c7ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x5c3a425d224493ddULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xc3d17d71ba96d005ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0xac9466a06b27590bULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x377ce3659f1de69aULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x5ca4543eefa89c44ULL },
+	{ KL_COLORBAR_SMPTE_RP_219_1, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xca7efb5992c8261cULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x1cceeec7b96dc8d2ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0xa9b0f9b9fd1a5dc5ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xed2cc6ae5db29ec4ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x427d971feccf1828ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x427d971feccf1828ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0xc05b6704a639196dULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x959de4e31e99e43fULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x99ae2487774c30bcULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x92501fe78751a535ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x3417a83b66e6392dULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x51c8691ee076d89eULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xf856b0766c12f816ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xa6556c74451575d3ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x9032b5d920d9dedaULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x9032b5d920d9dedaULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x284143a35a45a792ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x1b7bc4d79ae261b8ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xc09747888d97692aULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x05f786dd1b6cdaa3ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x11b53b4d0f50a9d3ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x2fa8720b831b389eULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x3262b493f751cbf5ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xed2cc6ae5db29ec4ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x427d971feccf1828ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x427d971feccf1828ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xc05b6704a639196dULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x959de4e31e99e43fULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x99ae2487774c30bcULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x92501fe78751a535ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x3417a83b66e6392dULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x06fb742016032e86ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x7860964999a20052ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xf2d4ed02a616015dULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x55fda05f72b66272ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x55fda05f72b66272ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xe13fb92c8c30b31bULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x44bde6aed57ef204ULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x1daaa8f31237a83bULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x667351505b6a271bULL },
+	{ KL_COLORBAR_BLACK, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xf3ab051df2b7b05bULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x28ec3ab5d519aba7ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x2c5ecbbacd64933cULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xad202be16e42c7fbULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x29b70ca4da50555dULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x29b70ca4da50555dULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0xc85137f784a1ae86ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x26ff5cd2f051e839ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xc61ccc76124c3101ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x30d1a1c68c428b29ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x369193fa2adf3010ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x355ec26b8b54b9e4ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x05af0822d308398eULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x86ddc0f2b617fc61ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x1e200a1ba0803b5cULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x1e200a1ba0803b5cULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0xf95884019fff3e78ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xb1be696f832b3b96ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x50e3efdb728beaa9ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xc94087abe9802c90ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x1d01fca3249ff3afULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xf8134293b2df81a3ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x10613f11ea707dfbULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xad202be16e42c7fbULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x29b70ca4da50555dULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x29b70ca4da50555dULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xc85137f784a1ae86ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x26ff5cd2f051e839ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xc61ccc76124c3101ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x30d1a1c68c428b29ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x369193fa2adf3010ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xbf5aa1c7fe004d63ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x7b8df33f47be6602ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xbef87b64d271a39cULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x3b6f2d3aae1ef616ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x3b6f2d3aae1ef616ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xf6ff7f315eeb6e9aULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0xa645e4d4a1661046ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x61c6234727b9fa84ULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x1c37e86f951c036eULL },
+	{ KL_COLORBAR_BLACK, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xbdbee0d78847eb5aULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x569d1a03fc41489cULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0xdd36e016e173d60dULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x8f2ef6cfac7d695eULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x935cc407346b0c18ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x935cc407346b0c18ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x0559deebc598e4f7ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x60c7b58d5c8f5acdULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x7a57da1685cf67bcULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0xd124270f75883b16ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xa74f05ae25531351ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xe4b1a7b9264574f5ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x23cce34477c8da24ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xcce46bf586fdb3aeULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xecbf8d55f6c864b5ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xecbf8d55f6c864b5ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x16f5abdc6884716fULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x2b7f7a966c45b610ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xc5e72de4ea82c61aULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x42857de1a39eb606ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x0398404aa8d1e2e0ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xd340894483580d26ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x3e0ec9dbc547ff56ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x8f2ef6cfac7d695eULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x935cc407346b0c18ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x935cc407346b0c18ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x0559deebc598e4f7ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x60c7b58d5c8f5acdULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x7a57da1685cf67bcULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xd124270f75883b16ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xa74f05ae25531351ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x66967c2f295108cbULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x6d4914a3875b2baeULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x94750a4f8d753059ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x53767d76eca73d26ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x53767d76eca73d26ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x6bf0038e8e7707a0ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x3f4bcebe59ecadbeULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x18d0b9b5be41bc65ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x4bc623aad8bdad46ULL },
+	{ KL_COLORBAR_BLACK, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x4646ebd6f87c4dcdULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x176afdeabecd8e3cULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x86c933950eea6b2fULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x3cbdbb737e7d324dULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x7da7dc7c760dd21cULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x7da7dc7c760dd21cULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x7bcf07e0a15f3c13ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x60e9f3fc5714ae42ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xddb63510014b08b9ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x5c45cb4b21eb6d26ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x464b6c54d5aee703ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x0d8c10642a181ab0ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x0174faded3212a57ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x20a8f389e1d81987ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xc9800ba008e86ec7ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xc9800ba008e86ec7ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x265ffa93d3b90d59ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xd15f94291351c385ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x46662714ee290c96ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x413c9e31e0c03ec5ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xe6c8c68cba589198ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xc090e51dba4d3b16ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0xfd9d3261e472e71dULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x3cbdbb737e7d324dULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x7da7dc7c760dd21cULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x7da7dc7c760dd21cULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x7bcf07e0a15f3c13ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x60e9f3fc5714ae42ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xddb63510014b08b9ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x5c45cb4b21eb6d26ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x464b6c54d5aee703ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x4b88b4489fe1fa53ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x0e61e0b130646d98ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xa1f53210f3a352ebULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xa39c412893fa0f79ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0xa39c412893fa0f79ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x44d21e60cdb4361dULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0xbc80059386056639ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x787271c6caab0839ULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x6467dfbc43807daaULL },
+	{ KL_COLORBAR_BLACK, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x6f0d261d389f18e6ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x1133e08ec9140cc6ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x912f5d37cea100dbULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xca051e6fe927ef27ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x14e807004d875f6bULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x5a92cd2279beb565ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x62547746b05f5b25ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x443371044afaccc1ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x5a31f355e5deed42ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0xe1a40a39232b5cc4ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x0b2856397359b49aULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x34536f5210991e36ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xb6b895c915f61a3cULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x4857100248a8a7aeULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x2f819e603c4e0a5cULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xe63a3d9bd158839cULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0xc016b0b1b9970594ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x34361036862bdb6dULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xd0f2a473e3f2d77dULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xe7df12d4128b0529ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xf3d0f90cb9cc7fd8ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x053ecb0b4ead1023ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0xf51b81f54da0ae61ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xca051e6fe927ef27ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x14e807004d875f6bULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x5a92cd2279beb565ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x62547746b05f5b25ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x443371044afaccc1ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x5a31f355e5deed42ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xe1a40a39232b5cc4ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x0b2856397359b49aULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x50883d468fff1827ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x6e812728a82bb755ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x707f836a7e421349ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x38f325f1facc71a8ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x5a7b85d216595ad5ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x36cd68a2a6825973ULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x82e1b875fd94991dULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xe79072ec4656a36cULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x0f65ca55f175f08cULL },
+	{ KL_COLORBAR_EIA_189A, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x078fa4dba4043a42ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x0216bc30df4b6610ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x77352e8195b30e59ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x2e9a32d95c359edcULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xfc2b16087f7fd5b6ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x83897025cf5831cfULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0xa34d0deb60fe3d4fULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x13f15a298bc00500ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xa163d6eca95fb070ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0xd7d5ccbf96635046ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xffd0303e45015da8ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x624ca764c621de18ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xd58d561928374fdcULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x5e8078943450c8bdULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xfea5e20407e1cee2ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xa7de11d6b5b2cecdULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x973d83f7427ced06ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x79c3fb7e3dbebd2dULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xe0f0b42dc7884608ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x687f489e2d4367b8ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x53bb9ec18f99a295ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x77af49ab33affa09ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x5835dadd4f82733dULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x2e9a32d95c359edcULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xfc2b16087f7fd5b6ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x83897025cf5831cfULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xa34d0deb60fe3d4fULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x13f15a298bc00500ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xa163d6eca95fb070ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xd7d5ccbf96635046ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xffd0303e45015da8ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x2eb603e6fec41ab8ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x9dd041d856c0ba14ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x1d9bc2620cb8de0eULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x9fae1136e859b8bfULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x8df92026fd818315ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xc39d7501a0e7de29ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0xac037b0af5421c20ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x0dc270c860b4eca5ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x48c8ce7399eb7e93ULL },
+	{ KL_COLORBAR_EIA_189A, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xf1ced14539081a8cULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x634d840b2ff787f7ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x3c605dbf4dd358deULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xc11f362c1574fd38ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x3abe7d5ca238cf49ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x3630348489657a5bULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x35b4c4b7b74a7335ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0xdbab19d21931e1f4ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xf098fe31428f38faULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0xb62806e2836450c6ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x09ff76e9b7067297ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xa7aa8fe37ebdcdf2ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x01100713a15b7982ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x8952a6deb75a898bULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x797b8bb0d7a52601ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x463e40bf70a9608fULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x287f9a8f236670c5ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x13f5c91e0e2f2c88ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x00380e75e6c75a63ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x17f08045a65688d1ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x813f1a6a1c573d2dULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x946d7241eca56a5dULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0xa2a39c24dbcfd63eULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xc11f362c1574fd38ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x3abe7d5ca238cf49ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x3630348489657a5bULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x35b4c4b7b74a7335ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0xdbab19d21931e1f4ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xf098fe31428f38faULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xb62806e2836450c6ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x09ff76e9b7067297ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x21ca572c383d4c5eULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0xeaf8fc8f3cb0b0daULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xa134e3466a1ee15cULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x49288462902a0c44ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0xca9826e50ab856dcULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xa405ef730e5a6ab2ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x74a7e49565cb1da9ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x01d98f02c1468c8fULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x5163993949103b61ULL },
+	{ KL_COLORBAR_EIA_189A, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x5ef3cf724c3e2a79ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x3af054280907560eULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x22053bb4d55d9af2ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x685af3d2a714406aULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x6116ecc6c65ef619ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x6aa0d9b454d22edeULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x1a00d8a988cb1ebcULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x5250969a52206010ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xc14fbc75667e404eULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x3613477d809c1d3bULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x161c6414610965eeULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x2737e3209d6d17c7ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x32950855448d7728ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x92a50a3b8b8e38bdULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xba67ce662580f394ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x80b2e00701c5855dULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x19cbb523b3444bbcULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xc3ed377a1f10e94aULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xe9634bb709c9a0ceULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xb168765e4df7a564ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x5a9b7c4546f5606bULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xdd230bf082d72bdcULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x7a3ffe2946fe6cc0ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x685af3d2a714406aULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x6116ecc6c65ef619ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x6aa0d9b454d22edeULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x1a00d8a988cb1ebcULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x5250969a52206010ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xc14fbc75667e404eULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x3613477d809c1d3bULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x161c6414610965eeULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x10aeffda729ef964ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x2a5e07b0e83378e0ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x76066f8fbd4e4e44ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xeb3967420ab9c00aULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x671f1c6b6a9762f3ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xe9934e64def6ccf1ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x268cf998052b5bccULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xc776442778829ff4ULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x18165a4a4acc39dcULL },
+	{ KL_COLORBAR_EIA_189A, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x276036aa178b4e37ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xf4a8fac34d4c9e02ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x78c38e14e47c0764ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xa103a5cac460c270ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x0da8dcbad36add73ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0xa4262af9d3a8ea78ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x2c3d8574bb288ea2ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0xacbd12222b87227aULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xb8f3c0f5325bd668ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0xb6ffbd5325dbab9dULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xb8f8b0db4de1580cULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xf69efd21bb23e448ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x907cfc1249ba1ca7ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x0484456cfbacd8f0ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x4aa06d8d5a138dd9ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x701665b9591e8c4aULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x94340e6e9cc0cb33ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xff6aa8cfdfff005eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x3de0e4e4fd1d8ea9ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x466e08a04ae34a9dULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x3fb402860b8f11fcULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xf6c0679ab45406ceULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0xdcae5e6fba7358b8ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x5742aa8386c6cf9eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xe64e0699500276b3ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x63518dd727247ca0ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xbf2da28962ca0f55ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0xaf12e12f46655d27ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x50fbe0f95b4121dfULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x62404d99f60b465fULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x137956960982f0dfULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x0ec9059571f123fcULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x513dcdbb811e8550ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x9d7efd329976259bULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x3fd0b686f49cdb1cULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x586371dada7ae7a8ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xa793ee5caa08f6f6ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x317ce6db34a507b5ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x2268298df4003d33ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x571cb1b3823b5860ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x5f3a19e2ecde64d2ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xc2b932520f6c82baULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x7efb0044f8b9cd75ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xc765a92fdf75c030ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x8d13eb40dd387b57ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0xcd585f3295aed4b3ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x4e85986036d7415cULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x70abe45d294f5e4eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xe8cbb4c3639b74f0ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x54ed19a1e1a1abf3ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xac0adddd7138a388ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xd64d55861dda13dbULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x027835ea1530b87eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xa3116164447fd588ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xed815a7458be39d8ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xb14f7f4175e93478ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x999e49af63cde18dULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x5ddbe337955ca3fcULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x6707b56fc10208a7ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xc5c9c6b7ba9dd6e4ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x234d0dad00b647d7ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xd9f0833f1f30d3ebULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x0a9f3bf2689e5743ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x27eaecdd933a47c8ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x5ad27491ebe8df78ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x1c0cb56cf799c5ecULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x98c5f486f803abafULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0xb38f61bf83994067ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x0a52ce5552a7e8c7ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x7eae052f342c79c0ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xc714226240f96647ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xf7087246599ed091ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x63d5b298f7d3a142ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x915b65f1c773ab89ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xf17341913590189bULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0xbf2475123cb0bbd8ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x96a95a1b98cf11f9ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x93a12ef3fbddee83ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x661d549509af7bfdULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0xf9a844434d5a46daULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xd572d63697c734aeULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x2a80d2856398e96cULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0xca60e96b24696ccaULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xcc5496da6556a7ceULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xad89328485cb6102ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x84005e5f8b9e93bfULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0xe03d785c69ce4602ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0xd8251a1422afc00fULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xe6aa0cf4f6a8987cULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x1dd5ebdb6a17524eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x71456db14da5dd31ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xb06c6fd76dfacf05ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xbbb256c1b27daca5ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x50b1808edbba6c6aULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x010603cc3c5052ceULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xe75afa3e1c1eaed7ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x145120eac51e6a72ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xeee601188e714424ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x13aa653d71c1a8edULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x30cf5b3bd3ac944fULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x30d187e56b1bbe35ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xf935d165df8715f4ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x485e32a0c97e6a86ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0xfb0d7f9616d01ceaULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xd8a470432a893f1fULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x0b7f74ff59737997ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x3bcc9f289b98ce0dULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x559e069a23a39f30ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x608bb669d4dedf10ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x104cdf36a1901f5cULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x0bb1550eb80abd6dULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xff0b9728e6af8461ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x6a667f8e2ef16de9ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xbdd89bf57db410e9ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x1bc0a4a7e2753c9bULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x6b8d7830b378592eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x3e78f6d847afc13bULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0xad12070d73ff0f22ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x771427759db7c6b8ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0xb0d5c7a2c9f2d29fULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xe55630c791dd8541ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xd736cc4d53473356ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0xa129b8cb7a3098c5ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x73412f00f8b572ddULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x10cee26f617d2cc2ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0xca6213af6b99f885ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0xe4d4a7452705db26ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0xc1094f3ed467a1feULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xdab0b84c8f831be2ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0xd9166d4825b08535ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x499b677a757ba93bULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x8734a9b52db96adcULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xc78d6e19370dafa5ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x43eb00e8620fbb0bULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x1cacb93df87fb7b4ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x038eeac737662861ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0xaba32203721e30a4ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xe3fb7547273c1b7eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x513f3f2dd201ef39ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xe6e2e5db0c6fca56ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x17baacd3127004f3ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xde01a7f26d057769ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x44e1edc26f6af82eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x17c27a762d054fcfULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xad302b8223908daeULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x7ea3acf24413d07eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x8cb6ec20fb147863ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x0cd7266bb39cad80ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x9aaaa7b15b3de8bcULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xe509444bd080b7bdULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x924ae1e7a1872c19ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x29e4e0e4a0e9b0c6ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x372e41ec73822bdfULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x2e6f822e823894fbULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x89410f221e4f3168ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x242ca2cc20c9a7f9ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x93377c2d53b542bbULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x482979bfb1cfe38bULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xbbda576e5cab538eULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x120809ff000bc890ULL },
+	{ KL_COLORBAR_SMPTE_RP_198, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x9fac51f39bea06b1ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x3d247f460d2493c2ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0xc206d89059b1461cULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x61cc6360aee44e9cULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x283804043f0e20efULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x283804043f0e20efULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0xdbb494e840f2469bULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x385304a55757cb12ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x26b7c90a24940099ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x0792b18c563dd47aULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x2b33d8cb26f88818ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x3d76ef6c7e73df7dULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x0e6f546f7e131424ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xb429b97d7b1312fcULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xfc9df4455ad3214cULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xfc9df4455ad3214cULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x1e492cf6379f1eceULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x04a04abf6055b17fULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xaa61f3237c0e7d01ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x6cd65e428eac6cfcULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xfd6e46b8b087738bULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xfcd2d7ddef78ba4eULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0xd5d255604c8eb2bfULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x61cc6360aee44e9cULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x283804043f0e20efULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x283804043f0e20efULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0xdbb494e840f2469bULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x385304a55757cb12ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x26b7c90a24940099ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x0792b18c563dd47aULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x2b33d8cb26f88818ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xe3034aed1539dddeULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x850c25850ad33ed4ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x285625f291ab7f3aULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x2b0ab7f079fb6615ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x2b0ab7f079fb6615ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0xe9beb0d147a8047aULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0xe7cf7251561990d4ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x06b1f85afa05f268ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x5034e58203b35b46ULL },
+	{ KL_COLORBAR_WHITE, 720, 486, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x8d8ae1caf5fd76bcULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x70fd4179ff9819eaULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x95b3f0fa8d04afd1ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x3c6527ac817fe438ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x132f66a137b01a94ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x132f66a137b01a94ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x0cda7b5625cdc7c1ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0xc061f7fb652df499ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x06eb05c6cc8858daULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0xa067c8a9682170bbULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x9d544c0e17c0b8dbULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xbb42700dbc949cc1ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xd76233e3c193b4e0ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x102961ae2288fcbeULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xc405921f1f1f5fa7ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0xc405921f1f1f5fa7ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0xaffdb284bab0b480ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x87d6136a0acc2dd7ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xad275765226822a0ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x07e08462740294c7ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0xe4cff58ad874eafeULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x3a4fd40cdfa5df8cULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x2aac8ff2d2a44864ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x3c6527ac817fe438ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x132f66a137b01a94ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x132f66a137b01a94ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x0cda7b5625cdc7c1ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0xc061f7fb652df499ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x06eb05c6cc8858daULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0xa067c8a9682170bbULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x9d544c0e17c0b8dbULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x96f7a294b8291721ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0xcac4a4a38ae924e7ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x77c30b3dfe6d7210ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xff0d87f628a94b93ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0xff0d87f628a94b93ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x48a8e4b5e5b01721ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x2beb8c7a97b69821ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0xf1202b3f57cded28ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0xfed27239d17b2173ULL },
+	{ KL_COLORBAR_WHITE, 1280, 720, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x50ee7fc524266916ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xd24e3cb5dba9a517ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x8eadfa16013c838dULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x120cf6ecbc857744ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xc2e53d27479daa39ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0xc2e53d27479daa39ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x09a05ba4410dfb68ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0x73318eae7a7cfc4dULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x586d6c412c9e4193ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x6c5d7c0cb69788fbULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x54cbbf1117898cf9ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x0c0a86efb9a303bcULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0xd5c705327add6805ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0xfe5661887c449a2fULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x78d9fbf5ba567976ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x78d9fbf5ba567976ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x3c8abc4e8460f342ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0xa941265c7c17b6b7ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x6500d9040be482ffULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0xf32d53bd0e0cb57fULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x9fc8dfa333dd6e3aULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0x4ac2b3104d3bb06bULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x2f78f7d67fc45185ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x120cf6ecbc857744ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0xc2e53d27479daa39ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0xc2e53d27479daa39ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x09a05ba4410dfb68ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0x73318eae7a7cfc4dULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0x586d6c412c9e4193ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x6c5d7c0cb69788fbULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0x54cbbf1117898cf9ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0x031ba40e9bc79611ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x322e76d4a604287dULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x946a877f4f1eaa81ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x7ef2592605b803baULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0x7ef2592605b803baULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x8c0d4eb84fd3ae60ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x1c138e13ecd53579ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x5c2079c5f9ae22c4ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0xf14917626ad2b197ULL },
+	{ KL_COLORBAR_WHITE, 1920, 1080, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x7c0c14849d7edbc0ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xd620d1d58a9a59c4ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_V210, 0x1d41701308db13deULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x241ac09ab24b5e3eULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x1832a35b7b067137ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_I420, 0x1832a35b7b067137ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P010, 0x7f4bcc1a2d1dd4f7ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_P216, 0xf087fb8179230192ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xa4f84df0ca95a276ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R210, 0x1a4de898d4f99b63ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xda3f9469a51fd69cULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xbc6a5bbcdca84174ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_V210, 0x1bc42c63c1c21d81ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x2692f91c361f53c0ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_NV12, 0x0d9236516f6c3873ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_I420, 0x0d9236516f6c3873ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P010, 0x546b27c3ec8c3d0fULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_P216, 0x5b8fbb47145d6066ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x633b1480750128eaULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R210, 0x15262b0ea520e14bULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_8BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x908908ecd8a3c923ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY, 0xe4b16034e710af99ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_V210, 0x38723615ae309162ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_UYVY16, 0x241ac09ab24b5e3eULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_NV12, 0x1832a35b7b067137ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_I420, 0x1832a35b7b067137ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P010, 0x7f4bcc1a2d1dd4f7ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_P216, 0xf087fb8179230192ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_BGRA, 0xa4f84df0ca95a276ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R210, 0x1a4de898d4f99b63ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 0, KL_COLORBAR_FORMAT_R12B, 0xda3f9469a51fd69cULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY, 0xea1111b60f9051ceULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_V210, 0x41a61d3509530632ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_UYVY16, 0x71775f92ff54a7f9ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_NV12, 0xf28210c2853707f1ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_I420, 0xf28210c2853707f1ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P010, 0x50d5449404acff19ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_P216, 0x14015d88e205daaaULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_BGRA, 0x5192530353c241b7ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R210, 0x47bb75a6e445c996ULL },
+	{ KL_COLORBAR_WHITE, 3840, 2160, KL_COLORBAR_10BIT, 1, KL_COLORBAR_FORMAT_R12B, 0x11d085cc2cfb4290ULL },
+};
+
+static const struct golden_tone golden_tones[] = {
+	{ KL_COLORBAR_SAMPLE_U8, 0, 0x7c5fc109be437288ULL },
+	{ KL_COLORBAR_SAMPLE_U8, 1, 0x54c4e8913bc87a6eULL },
+	{ KL_COLORBAR_SAMPLE_U8, 2, 0x7c5fc109be437288ULL },
+	{ KL_COLORBAR_SAMPLE_U8, 3, 0x54c4e8913bc87a6eULL },
+	{ KL_COLORBAR_SAMPLE_S8, 0, 0x90d4006d925e0bc0ULL },
+	{ KL_COLORBAR_SAMPLE_S8, 1, 0xd32790c82d78a8e8ULL },
+	{ KL_COLORBAR_SAMPLE_S8, 2, 0x90d4006d925e0bc0ULL },
+	{ KL_COLORBAR_SAMPLE_S8, 3, 0xd32790c82d78a8e8ULL },
+	{ KL_COLORBAR_SAMPLE_U16, 0, 0x9fb383fd1993ce1dULL },
+	{ KL_COLORBAR_SAMPLE_U16, 1, 0x7f54fbb770651409ULL },
+	{ KL_COLORBAR_SAMPLE_U16, 2, 0x466f6c0f85070f7bULL },
+	{ KL_COLORBAR_SAMPLE_U16, 3, 0x78467f6ddcb4d578ULL },
+	{ KL_COLORBAR_SAMPLE_S16, 0, 0x26a7b7364ca3980fULL },
+	{ KL_COLORBAR_SAMPLE_S16, 1, 0x9e4796129fbde129ULL },
+	{ KL_COLORBAR_SAMPLE_S16, 2, 0xdeb66a65a136bc50ULL },
+	{ KL_COLORBAR_SAMPLE_S16, 3, 0x94ea5b9ee62f375eULL },
+	{ KL_COLORBAR_SAMPLE_S24_32, 0, 0x8c7279937a4343a1ULL },
+	{ KL_COLORBAR_SAMPLE_S24_32, 1, 0x2fbd0e44f950ca3dULL },
+	{ KL_COLORBAR_SAMPLE_S24_32, 2, 0xf161826cb252856eULL },
+	{ KL_COLORBAR_SAMPLE_S24_32, 3, 0x0489445e7e33cba9ULL },
+	{ KL_COLORBAR_SAMPLE_S32, 0, 0xd1953bb1c11a0e82ULL },
+	{ KL_COLORBAR_SAMPLE_S32, 1, 0xe909fbb7baa1152cULL },
+	{ KL_COLORBAR_SAMPLE_S32, 2, 0xfcde18fa7e066634ULL },
+	{ KL_COLORBAR_SAMPLE_S32, 3, 0x059a4885fd5f180aULL },
+	{ KL_COLORBAR_SAMPLE_FLOAT32, 0, 0xd1b19ab42a920b1cULL },
+	{ KL_COLORBAR_SAMPLE_FLOAT32, 1, 0x6b820981795bdbdbULL },
+	{ KL_COLORBAR_SAMPLE_FLOAT32, 2, 0x55e7b1638aa77113ULL },
+	{ KL_COLORBAR_SAMPLE_FLOAT32, 3, 0xc6418f35d99ccb6dULL },
+};
+
+static const struct golden_feature golden_features[] = {
+	{ "tone ident 8ch S16", 0x58db3e54db71e2e5ULL },
+	{ "tone ident 8ch S24_32 planar", 0x1663a493604bcca5ULL },
+	{ "tone ebu3304 4ch FLOAT32 big endian", 0x1d4189a1a7f56febULL },
+	{ "tone ebu3304 2ch U8", 0x7fdc38fd688aa50aULL },
+	{ "sequence 1280x720 8-bit", 0xa88e8627476c82fbULL },
+	{ "sequence 1280x720 10-bit", 0x8aebfdf2a3a376b6ULL },
+	{ "sequence 722x486 8-bit", 0x4fbf20bfddb8c94fULL },
+	{ "sequence 722x486 10-bit", 0x118efcc381a5f51cULL },
+};
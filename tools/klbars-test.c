@@ -1,14 +1,1577 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include <stdatomic.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <libklbars/klbars.h>
+#include "klbars-internal.h"
 
-int main()
+/* Regression test against golden checksums.
+
+   Every built in pattern is rendered at SD, 720p, 1080p and UHD, with
+   8 and 10-bit internal buffers, with and without text, and finalized
+   into every output format.  A hash of each result is compared with
+   the one recorded in klbars-test-golden.h from the scalar kernels.
+   The whole run is repeated at each instruction set level the CPU
+   has, and again spread over several threads, so every SIMD kernel
+   variant has to match the plain C one to the bit.  Tones in every
+   sample format and layout are checked the same way.
+
+   The paths that only redraw or copy part of a frame (dirty tracking,
+   the shared pattern cache, caller owned buffers) are run through a
+   sequence of frames with counters and translucent text, which has to
+   come out the same as from a plain context, and multichannel tones,
+   the audio cadence, the A/V sync analyzer, the pattern verifier and
+   pacing against a mock clock are each checked too.
+
+   Run with -g to print a new golden table, after a change to the
+   output that is meant. */
+
+struct golden_frame {
+	int pattern;
+	int width;
+	int height;
+	int depth;
+	int text;
+	enum kl_colorbar_format format;
+	uint64_t hash;
+};
+
+struct golden_tone {
+	enum kl_colorbar_sample_format format;
+	unsigned int flags;
+	uint64_t hash;
+};
+
+struct golden_feature {
+	const char *name;
+	uint64_t hash;
+};
+
+#include "klbars-test-golden.h"
+
+#define NUM_GOLDEN_FRAMES (sizeof(golden_frames) / sizeof(golden_frames[0]))
+#define NUM_GOLDEN_TONES (sizeof(golden_tones) / sizeof(golden_tones[0]))
+#define NUM_GOLDEN_FEATURES (sizeof(golden_features) / sizeof(golden_features[0]))
+
+/* Threads for the threaded pass */
+#define TEST_THREADS 4
+
+static const struct {
+	int width;
+	int height;
+} resolutions[] = {
+	{ 720, 486 },
+	{ 1280, 720 },
+	{ 1920, 1080 },
+	{ 3840, 2160 },
+};
+
+static const struct {
+	enum kl_colorbar_format format;
+	const char *name;
+	const char *symbol;
+} formats[] = {
+	{ KL_COLORBAR_FORMAT_UYVY, "UYVY", "KL_COLORBAR_FORMAT_UYVY" },
+	{ KL_COLORBAR_FORMAT_V210, "V210", "KL_COLORBAR_FORMAT_V210" },
+	{ KL_COLORBAR_FORMAT_UYVY16, "UYVY16", "KL_COLORBAR_FORMAT_UYVY16" },
+	{ KL_COLORBAR_FORMAT_NV12, "NV12", "KL_COLORBAR_FORMAT_NV12" },
+	{ KL_COLORBAR_FORMAT_I420, "I420", "KL_COLORBAR_FORMAT_I420" },
+	{ KL_COLORBAR_FORMAT_P010, "P010", "KL_COLORBAR_FORMAT_P010" },
+	{ KL_COLORBAR_FORMAT_P216, "P216", "KL_COLORBAR_FORMAT_P216" },
+	{ KL_COLORBAR_FORMAT_BGRA, "BGRA", "KL_COLORBAR_FORMAT_BGRA" },
+	{ KL_COLORBAR_FORMAT_R210, "R210", "KL_COLORBAR_FORMAT_R210" },
+	{ KL_COLORBAR_FORMAT_R12B, "R12B", "KL_COLORBAR_FORMAT_R12B" },
+};
+
+#define NUM_FORMATS (sizeof(formats) / sizeof(formats[0]))
+
+static const struct {
+	enum kl_colorbar_sample_format format;
+	const char *name;
+} sample_formats[] = {
+	{ KL_COLORBAR_SAMPLE_U8, "KL_COLORBAR_SAMPLE_U8" },
+	{ KL_COLORBAR_SAMPLE_S8, "KL_COLORBAR_SAMPLE_S8" },
+	{ KL_COLORBAR_SAMPLE_U16, "KL_COLORBAR_SAMPLE_U16" },
+	{ KL_COLORBAR_SAMPLE_S16, "KL_COLORBAR_SAMPLE_S16" },
+	{ KL_COLORBAR_SAMPLE_S24_32, "KL_COLORBAR_SAMPLE_S24_32" },
+	{ KL_COLORBAR_SAMPLE_S32, "KL_COLORBAR_SAMPLE_S32" },
+	{ KL_COLORBAR_SAMPLE_FLOAT32, "KL_COLORBAR_SAMPLE_FLOAT32" },
+};
+
+/* Names of the patterns for the golden table, by enum value */
+static const char *pattern_symbols[] = {
+	"KL_COLORBAR_SMPTE_RP_219_1",
+	"KL_COLORBAR_BLACK",
+	"KL_COLORBAR_EIA_189A",
+	"KL_COLORBAR_SMPTE_RP_198",
+	"KL_COLORBAR_WHITE",
+};
+
+static const char *level_names[] = { "scalar", "sse2", "ssse3", "avx2" };
+
+static int generate;
+static int failures;
+
+/* 64-bit FNV-1a over little endian words, so the same bytes hash the
+   same on any host, folded as it goes to spread the high bits down.
+   Four words at a time go into four separate hashes, which the CPU
+   can work on together, and are then hashed into one. */
+static inline uint64_t load_le64(const unsigned char *p)
+{
+	uint64_t w;
+
+	memcpy(&w, p, sizeof(w));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	w = __builtin_bswap64(w);
+#endif
+	return w;
+}
+
+static inline uint64_t hash_word(uint64_t h, uint64_t w)
+{
+	h = (h ^ w) * 0x100000001b3ULL;
+	return h ^ (h >> 32);
+}
+
+static uint64_t hash_bytes(uint64_t h, const unsigned char *p, size_t n)
+{
+	uint64_t lane[4] = { h, h ^ 1, h ^ 2, h ^ 3 };
+	size_t i = 0;
+
+	for (; i + 32 <= n; i += 32) {
+		for (int l = 0; l < 4; l++)
+			lane[l] = hash_word(lane[l], load_le64(p + i + l * 8));
+	}
+	for (int l = 0; l < 4; l++)
+		h = hash_word(h, lane[l]);
+	for (; i + 8 <= n; i += 8)
+		h = hash_word(h, load_le64(p + i));
+	for (; i < n; i++)
+		h = (h ^ p[i]) * 0x100000001b3ULL;
+	return h;
+}
+
+#define HASH_INIT 0xcbf29ce484222325ULL
+
+/* Bytes per row and rows of each plane of a format */
+static int plane_layout(enum kl_colorbar_format format, int width, int height,
+			size_t *stride, int *rows)
+{
+	const int half = (height + 1) / 2;
+
+	memset(stride, 0, sizeof(*stride) * 3);
+	memset(rows, 0, sizeof(*rows) * 3);
+	rows[0] = height;
+	switch (format) {
+	case KL_COLORBAR_FORMAT_UYVY:
+		stride[0] = width * 2;
+		return 1;
+	case KL_COLORBAR_FORMAT_V210:
+		stride[0] = ((width + 47) / 48) * 128;
+		return 1;
+	case KL_COLORBAR_FORMAT_UYVY16:
+	case KL_COLORBAR_FORMAT_BGRA:
+	case KL_COLORBAR_FORMAT_R210:
+		stride[0] = width * 4;
+		return 1;
+	case KL_COLORBAR_FORMAT_R12B:
+		stride[0] = ((width + 7) / 8) * 36;
+		return 1;
+	case KL_COLORBAR_FORMAT_NV12:
+		stride[0] = stride[1] = width;
+		rows[1] = half;
+		return 2;
+	case KL_COLORBAR_FORMAT_I420:
+		stride[0] = width;
+		stride[1] = stride[2] = (width + 1) / 2;
+		rows[1] = rows[2] = half;
+		return 3;
+	case KL_COLORBAR_FORMAT_P010:
+		stride[0] = stride[1] = width * 2;
+		rows[1] = half;
+		return 2;
+	case KL_COLORBAR_FORMAT_P216:
+		stride[0] = stride[1] = width * 2;
+		rows[1] = height;
+		return 2;
+	}
+	return 0;
+}
+
+/* Render one case, spread over the given number of threads, into every
+   output format, hashing each */
+static int render_case(int pattern, int width, int height, int depth, int text,
+		       unsigned int threads, uint64_t *hashes)
+{
+	struct kl_colorbar_context ctx;
+	char str[] = "Hello World!";
+
+	if (kl_colorbar_init(&ctx, width, height, depth) < 0)
+		return -1;
+	if (kl_colorbar_set_threads(&ctx, threads) < 0 ||
+	    kl_colorbar_fill_pattern(&ctx, pattern) < 0) {
+		kl_colorbar_free(&ctx);
+		return -1;
+	}
+	if (text)
+		kl_colorbar_render_string(&ctx, str, strlen(str), 0, 2);
+
+	for (unsigned int f = 0; f < NUM_FORMATS; f++) {
+		struct kl_colorbar_planes out;
+		size_t stride[3], size = 0, offset = 0;
+		int rows[3], planes;
+		unsigned char *buf;
+
+		planes = plane_layout(formats[f].format, width, height, stride, rows);
+		for (int p = 0; p < planes; p++)
+			size += stride[p] * rows[p];
+		buf = calloc(1, size);
+		if (buf == NULL) {
+			kl_colorbar_free(&ctx);
+			return -1;
+		}
+
+		memset(&out, 0, sizeof(out));
+		out.format = formats[f].format;
+		for (int p = 0; p < planes; p++) {
+			out.data[p] = buf + offset;
+			out.stride[p] = stride[p];
+			offset += stride[p] * rows[p];
+		}
+
+		if (kl_colorbar_finalize_planes(&ctx, &out) < 0) {
+			free(buf);
+			kl_colorbar_free(&ctx);
+			return -1;
+		}
+		hashes[f] = hash_bytes(HASH_INIT, buf, size);
+		free(buf);
+	}
+
+	kl_colorbar_free(&ctx);
+	return 0;
+}
+
+static const struct golden_frame *find_frame(int pattern, int width, int height, int depth,
+					     int text, enum kl_colorbar_format format)
+{
+	for (unsigned int i = 0; i < NUM_GOLDEN_FRAMES; i++) {
+		const struct golden_frame *g = &golden_frames[i];
+
+		if (g->pattern == pattern && g->width == width && g->height == height &&
+		    g->depth == depth && g->text == text && g->format == format)
+			return g;
+	}
+	return NULL;
+}
+
+/* Every pattern, resolution, depth, text and format once */
+static int check_frames(const char *pass, unsigned int threads)
+{
+	struct kl_colorbar_context probe;
+	int bad = 0, checked = 0;
+
+	kl_colorbar_init(&probe, 1920, 1080, KL_COLORBAR_10BIT);
+	for (int pattern = 0; kl_colorbar_get_pattern_name(&probe, pattern); pattern++)
+	for (unsigned int r = 0; r < sizeof(resolutions) / sizeof(resolutions[0]); r++)
+	for (int depth = KL_COLORBAR_8BIT; depth <= KL_COLORBAR_10BIT; depth++)
+	for (int text = 0; text <= 1; text++) {
+		const int width = resolutions[r].width, height = resolutions[r].height;
+		uint64_t hashes[NUM_FORMATS];
+
+		if (generate && pattern >= (int)(sizeof(pattern_symbols) / sizeof(pattern_symbols[0]))) {
+			fprintf(stderr, "Pattern %d needs adding to pattern_symbols\n", pattern);
+			return 1;
+		}
+
+		if (render_case(pattern, width, height, depth, text, threads, hashes) < 0) {
+			printf("FAIL %s: %s %dx%d could not be rendered\n", pass,
+			       kl_colorbar_get_pattern_name(&probe, pattern), width, height);
+			bad++;
+			continue;
+		}
+
+		for (unsigned int f = 0; f < NUM_FORMATS; f++) {
+			const struct golden_frame *g;
+
+			if (generate) {
+				printf("\t{ %s, %d, %d, %s, %d, %s, 0x%016llxULL },\n",
+				       pattern_symbols[pattern], width, height,
+				       depth == KL_COLORBAR_10BIT ? "KL_COLORBAR_10BIT" :
+				       "KL_COLORBAR_8BIT", text, formats[f].symbol,
+				       (unsigned long long)hashes[f]);
+				continue;
+			}
+			g = find_frame(pattern, width, height, depth, text, formats[f].format);
+			checked++;
+			if (g == NULL) {
+				printf("FAIL %s: no golden value for %s %dx%d %d-bit%s %s\n", pass,
+				       kl_colorbar_get_pattern_name(&probe, pattern), width, height,
+				       depth == KL_COLORBAR_10BIT ? 10 : 8, text ? " text" : "",
+				       formats[f].name);
+				bad++;
+			} else if (g->hash != hashes[f]) {
+				printf("FAIL %s: %s %dx%d %d-bit%s %s hash %016llx, expected %016llx\n",
+				       pass, kl_colorbar_get_pattern_name(&probe, pattern), width,
+				       height, depth == KL_COLORBAR_10BIT ? 10 : 8, text ? " text" : "",
+				       formats[f].name, (unsigned long long)hashes[f],
+				       (unsigned long long)g->hash);
+				bad++;
+			}
+		}
+	}
+	kl_colorbar_free(&probe);
+
+	if (!generate)
+		printf("%-8s frames: %d checked, %d failed\n", pass, checked, bad);
+	return bad;
+}
+
+static int check_tones(const char *pass)
+{
+	int bad = 0, checked = 0;
+
+	for (unsigned int s = 0; s < sizeof(sample_formats) / sizeof(sample_formats[0]); s++)
+	for (unsigned int flags = 0; flags < 4; flags++) {
+		struct kl_colorbar_audio_context audio_ctx;
+		uint64_t hash = 0;
+		unsigned int i;
+
+		if (kl_colorbar_tonegenerator_create(&audio_ctx, 997, sample_formats[s].format,
+						     flags, 3, 48000) == 0) {
+			hash = hash_bytes(HASH_INIT, audio_ctx.audio_data,
+					  audio_ctx.audio_data_size);
+			kl_colorbar_tonegenerator_free(&audio_ctx);
+		}
+
+		if (generate) {
+			printf("\t{ %s, %u, 0x%016llxULL },\n", sample_formats[s].name, flags,
+			       (unsigned long long)hash);
+			continue;
+		}
+		checked++;
+		for (i = 0; i < NUM_GOLDEN_TONES; i++) {
+			if (golden_tones[i].format == sample_formats[s].format &&
+			    golden_tones[i].flags == flags)
+				break;
+		}
+		if (i == NUM_GOLDEN_TONES) {
+			printf("FAIL %s: no golden value for tone %s flags %u\n", pass,
+			       sample_formats[s].name, flags);
+			bad++;
+		} else if (golden_tones[i].hash != hash) {
+			printf("FAIL %s: tone %s flags %u hash %016llx, expected %016llx\n",
+			       pass, sample_formats[s].name, flags, (unsigned long long)hash,
+			       (unsigned long long)golden_tones[i].hash);
+			bad++;
+		}
+	}
+
+	if (!generate)
+		printf("%-8s tones: %d checked, %d failed\n", pass, checked, bad);
+	return bad;
+}
+
+/* The runtime pattern format: EIA-189A written out as text has to
+   render the same as the built in one, and malformed descriptions have
+   to be turned away */
+static const char pattern_eia189_sd[] =
+	"# EIA-189A, as the built in SD layout\n"
+	"name EIA-189A from text\n"
+	"band 3/4\n"
+	"solid 1/7 0x2d0 0x200 0x200\n"
+	"solid 1/7 0x288 0x0b0 0x238\n"
+	"solid 1/7 0x20c 0x270 0x0b0\n"
+	"solid 1/7 0x1c0 0x120 0x0e8\n"
+	"solid 1/7 0x150 0x2e0 0x318\n"
+	"solid 1/7 0x104 0x190 0x350\n"
+	"solid 1/7 0x08c 0x350 0x1c8\n"
+	"band 0.25\n"
+	"solid 5/28 0x040 0x278 0x17c  # -I\n"
+	"solid 5/28 0x3ac 0x200 0x200\n"
+	"solid 5/28 0x040 0x2b4 0x250\n"
+	"solid 13/28 64 512 512\n";
+
+static const struct {
+	const char *text;
+	const char *why;
+} bad_patterns[] = {
+	{ "", "no bands" },
+	{ "band 1/2\nband 1/2\nsolid 1 64 512 512\n", "an empty band" },
+	{ "band 1\nsolid 1 64 512 512\nband 1/2\n", "an empty last band" },
+	{ "solid 1 64 512 512\n", "a span outside a band" },
+	{ "band nan\nsolid 1 64 512 512\n", "a NaN height" },
+	{ "band 1\nsolid NAN 64 512 512\n", "a NaN width" },
+	{ "band 1/nan\nsolid 1 64 512 512\n", "a NaN denominator" },
+	{ "band inf\nsolid 1 64 512 512\n", "an infinite height" },
+	{ "band 1/inf\nsolid 1 64 512 512\n", "an infinite denominator" },
+	{ "band 0\nsolid 1 64 512 512\n", "a zero height" },
+	{ "band 1/0\nsolid 1 64 512 512\n", "a zero denominator" },
+	{ "band 1\nsolid 0 64 512 512\n", "a zero width" },
+	{ "band 1\nsolid 1 1024 512 512\n", "a component above 1023" },
+	{ "band 1\nsolid 1 64 0x400 512\n", "a hex component above 1023" },
+	{ "band 1\nramp 1 64 512 512 940 512 1024\n", "a ramp end above 1023" },
+	{ "band 1\nsolid 1 64 512\n", "a missing component" },
+	{ "band 1 1\nsolid 1 64 512 512\n", "a token after a height" },
+	{ "band 1\nsolid 1 64 512 512 512\n", "a token after a solid" },
+	{ "band 1\nramp 1 64 512 512 940 512 512 0\n", "a token after a ramp" },
+	{ "band 1\nsolid 1 64 512 512\nstripe 1\n", "an unknown statement" },
+};
+
+static int pattern_hash(int pattern, uint64_t *hash)
+{
+	const unsigned int width = 720, height = 486, stride = width * 2;
+	struct kl_colorbar_context ctx;
+	unsigned char *buf;
+	int ret = -1;
+
+	buf = calloc(height, stride);
+	if (buf == NULL)
+		return -1;
+	if (kl_colorbar_init(&ctx, width, height, KL_COLORBAR_8BIT) == 0) {
+		if (kl_colorbar_fill_pattern(&ctx, pattern) == 0 &&
+		    kl_colorbar_finalize(&ctx, buf, KL_COLORBAR_8BIT, stride) == 0) {
+			*hash = hash_bytes(HASH_INIT, buf, (size_t)stride * height);
+			ret = 0;
+		}
+		kl_colorbar_free(&ctx);
+	}
+	free(buf);
+	return ret;
+}
+
+static int check_pattern_file(void)
+{
+	char filename[] = "/tmp/klbars-test-XXXXXX";
+	uint64_t expect, hash;
+	int checked = 0, bad = 0;
+	int fd, id;
+
+	/* Through a file, as kl_colorbar_load_pattern() reads them */
+	checked++;
+	fd = mkstemp(filename);
+	if (fd < 0 || write(fd, pattern_eia189_sd, strlen(pattern_eia189_sd)) < 0) {
+		id = -1;
+	} else {
+		id = kl_colorbar_load_pattern(filename);
+	}
+	if (fd >= 0) {
+		close(fd);
+		unlink(filename);
+	}
+	if (id < KL_COLORBAR_USER_PATTERN ||
+	    pattern_hash(KL_COLORBAR_EIA_189A, &expect) < 0 || pattern_hash(id, &hash) < 0 ||
+	    hash != expect) {
+		printf("FAIL pattern file: EIA-189A from text doesn't match the built in one\n");
+		bad++;
+	}
+
+	for (unsigned int i = 0; i < sizeof(bad_patterns) / sizeof(bad_patterns[0]); i++) {
+		checked++;
+		if (kl_colorbar_parse_pattern(bad_patterns[i].text) >= 0) {
+			printf("FAIL pattern file: %s was accepted\n", bad_patterns[i].why);
+			bad++;
+		}
+	}
+
+	printf("%-8s pattern file: %d checked, %d failed\n", "patterns", checked, bad);
+	return bad;
+}
+
+/* Compare a hash with the golden one of the given name, or print it as
+   a new golden entry */
+static int check_feature(const char *pass, const char *name, uint64_t hash)
+{
+	if (generate) {
+		printf("\t{ \"%s\", 0x%016llxULL },\n", name, (unsigned long long)hash);
+		return 0;
+	}
+	for (unsigned int i = 0; i < NUM_GOLDEN_FEATURES; i++) {
+		if (strcmp(golden_features[i].name, name) != 0)
+			continue;
+		if (golden_features[i].hash == hash)
+			return 0;
+		printf("FAIL %s: %s hash %016llx, expected %016llx\n", pass, name,
+		       (unsigned long long)hash, (unsigned long long)golden_features[i].hash);
+		return 1;
+	}
+	printf("FAIL %s: no golden value for %s\n", pass, name);
+	return 1;
+}
+
+/* Channel identification and line-up tones, and the level limit */
+static int check_multi_tones(const char *pass)
+{
+	static const struct {
+		const char *name;
+		int ebu3304;
+		int channels;
+		enum kl_colorbar_sample_format format;
+		unsigned int flags;
+	} cases[] = {
+		{ "tone ident 8ch S16", 0, 8, KL_COLORBAR_SAMPLE_S16, 0 },
+		{ "tone ident 8ch S24_32 planar", 0, 8, KL_COLORBAR_SAMPLE_S24_32,
+		  KL_COLORBAR_AUDIO_PLANAR },
+		{ "tone ebu3304 4ch FLOAT32 big endian", 1, 4, KL_COLORBAR_SAMPLE_FLOAT32,
+		  KL_COLORBAR_AUDIO_BIG_ENDIAN },
+		{ "tone ebu3304 2ch U8", 1, 2, KL_COLORBAR_SAMPLE_U8, 0 },
+	};
+	struct kl_colorbar_tone_spec specs[8];
+	struct kl_colorbar_audio_context audio_ctx;
+	int bad = 0, checked = 0;
+
+	for (unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		uint64_t hash = 0;
+
+		if (cases[i].ebu3304)
+			kl_colorbar_tone_specs_ebu3304(specs, cases[i].channels);
+		else
+			kl_colorbar_tone_specs_ident(specs, cases[i].channels);
+		if (kl_colorbar_tonegenerator_multi(&audio_ctx, specs, cases[i].channels,
+						    cases[i].format, cases[i].flags, 48000) == 0) {
+			hash = hash_bytes(HASH_INIT, audio_ctx.audio_data,
+					  audio_ctx.audio_data_size);
+			kl_colorbar_tonegenerator_free(&audio_ctx);
+		}
+		bad += check_feature(pass, cases[i].name, hash);
+		checked++;
+	}
+
+	/* Full scale reaches the largest sample exactly, and no further */
+	kl_colorbar_tone_specs_ident(specs, 1);
+	specs[0].freq_hz = 1000;
+	specs[0].level_dbfs = 0;
+	if (kl_colorbar_tonegenerator_multi(&audio_ctx, specs, 1, KL_COLORBAR_SAMPLE_S16, 0,
+					    48000) < 0) {
+		printf("FAIL %s: 0dBFS tone could not be generated\n", pass);
+		bad++;
+	} else {
+		int16_t lo = 0, hi = 0;
+
+		for (size_t i = 0; i < audio_ctx.samples; i++) {
+			int16_t v;
+
+			memcpy(&v, audio_ctx.audio_data + i * 2, sizeof(v));
+			if (v < lo)
+				lo = v;
+			if (v > hi)
+				hi = v;
+		}
+		if (hi != 32767 || lo != -32767) {
+			printf("FAIL %s: 0dBFS tone peaks at %d and %d\n", pass, lo, hi);
+			bad++;
+		}
+		kl_colorbar_tonegenerator_free(&audio_ctx);
+	}
+	specs[0].level_dbfs = 6;
+	if (kl_colorbar_tonegenerator_multi(&audio_ctx, specs, 1, KL_COLORBAR_SAMPLE_S16, 0,
+					    48000) == 0) {
+		printf("FAIL %s: +6dBFS tone was accepted\n", pass);
+		kl_colorbar_tonegenerator_free(&audio_ctx);
+		bad++;
+	}
+	checked += 2;
+
+	if (!generate)
+		printf("%-8s multichannel tones: %d checked, %d failed\n", pass, checked, bad);
+	return bad;
+}
+
+/* The tone conversion kernels against the C ones on input past full
+   scale too, which no tone the library makes reaches */
+static int check_kernels(const char *pass)
+{
+	static const float edges[] = {
+		0, 0.5f, -0.5f, 1, -1, 1.0001f, -1.0001f, 1.5f, -1.5f, 2, -2,
+		1e30f, -1e30f, INFINITY, -INFINITY,
+	};
+	const struct {
+		const char *name;
+		kl_tone_pack_fn fn, ref;
+		float scale;
+	} kernels[] = {
+		{ "tone_s16", kl_kernels.tone_s16, kl_tone_s16_c, 32767.0f },
+		{ "tone_s32 (S24_32)", kl_kernels.tone_s32, kl_tone_s32_c, 8388607.0f },
+		{ "tone_s32", kl_kernels.tone_s32, kl_tone_s32_c, 2147483647.0f },
+		{ "tone_f32", kl_kernels.tone_f32, kl_tone_f32_c, 1.0f },
+	};
+	/* Odd, so the kernels' tails are run too */
+	float in[67];
+	uint8_t out[sizeof(in)], ref[sizeof(in)];
+	const unsigned int count = sizeof(in) / sizeof(in[0]);
+	int bad = 0, checked = 0;
+
+	for (unsigned int i = 0; i < count; i++) {
+		const unsigned int n = sizeof(edges) / sizeof(edges[0]);
+
+		in[i] = i < n ? edges[i] : -3.0f + 6.0f * (i - n) / (count - n);
+	}
+
+	for (unsigned int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+	for (int swap = 0; swap <= 1; swap++) {
+		memset(out, 0, sizeof(out));
+		memset(ref, 0, sizeof(ref));
+		kernels[k].fn(in, out, count, kernels[k].scale, swap);
+		kernels[k].ref(in, ref, count, kernels[k].scale, swap);
+		checked++;
+		if (memcmp(out, ref, sizeof(out)) != 0) {
+			printf("FAIL %s: %s%s differs from the C kernel past full scale\n", pass,
+			       kernels[k].name, swap ? " swapped" : "");
+			bad++;
+		}
+	}
+
+	printf("%-8s kernels: %d checked, %d failed\n", pass, checked, bad);
+	return bad;
+}
+
+/* An odd width leaves the last pixel of an 8-bit line half a chroma
+   pair, which has to come out the colour of the bar it is in */
+static int check_odd_width(const char *pass)
+{
+	static const enum kl_colorbar_format odd_formats[] = {
+		KL_COLORBAR_FORMAT_BGRA,
+		KL_COLORBAR_FORMAT_I420,
+		KL_COLORBAR_FORMAT_P216,
+	};
+	const int width = 721, height = 8;
+	struct kl_colorbar_context ctx;
+	int bad = 0;
+
+	if (kl_colorbar_init(&ctx, width, height, KL_COLORBAR_8BIT) < 0 ||
+	    kl_colorbar_fill_pattern(&ctx, KL_COLORBAR_EIA_189A) < 0)
+		return 1;
+
+	for (unsigned int f = 0; f < sizeof(odd_formats) / sizeof(odd_formats[0]); f++) {
+		struct kl_colorbar_frame frame;
+		const struct kl_colorbar_planes *out = &frame.planes;
+		size_t size = kl_frame_layout(&ctx, odd_formats[f], NULL, NULL);
+		unsigned char *buf = size ? calloc(1, size) : NULL;
+		int same = 1;
+
+		if (buf == NULL) {
+			bad++;
+			break;
+		}
+		kl_frame_layout(&ctx, odd_formats[f], &frame, buf);
+
+		if (kl_colorbar_finalize_planes(&ctx, out) < 0) {
+			same = 0;
+		} else if (odd_formats[f] == KL_COLORBAR_FORMAT_BGRA) {
+			same = memcmp(out->data[0] + (width - 1) * 4, out->data[0] + (width - 2) * 4,
+				      4) == 0;
+		} else if (odd_formats[f] == KL_COLORBAR_FORMAT_I420) {
+			const int c = (width + 1) / 2 - 1;
+
+			same = out->data[1][c] == out->data[1][c - 1] &&
+			       out->data[2][c] == out->data[2][c - 1];
+		} else {
+			/* Cb and Cr interleaved, 16 bits each */
+			const unsigned char *p = out->data[1] + ((width + 1) / 2 - 1) * 4;
+
+			same = memcmp(p, p - 4, 4) == 0;
+		}
+		if (!same) {
+			printf("FAIL %s: the last pixel of a %d wide frame is the wrong colour\n",
+			       pass, width);
+			bad++;
+		}
+		free(buf);
+	}
+	printf("%-8s odd width: %d checked, %d failed\n", pass,
+	       (int)(sizeof(odd_formats) / sizeof(odd_formats[0])), bad);
+
+	kl_colorbar_free(&ctx);
+	return bad;
+}
+
+/* A sequence of frames through the paths that only redraw or copy part
+   of the frame, with counters and translucent text.  Every variant has
+   to give the same frames as a plain context does. */
+#define SEQ_FRAMES 8
+
+#define SEQ_DIRTY    0x1
+#define SEQ_CACHE    0x2
+#define SEQ_EXTERNAL 0x4
+#define SEQ_THREADS  0x8
+
+static const struct {
+	int pattern;
+	const char *text;
+	unsigned int x;
+	unsigned int y;
+	int alpha; /* Text background from this frame on, or -1 to leave it */
+} seq_frames[SEQ_FRAMES] = {
+	{ KL_COLORBAR_SMPTE_RP_219_1, "Hello", 0, 2, -1 },
+	{ KL_COLORBAR_SMPTE_RP_219_1, "World", 3, 6, -1 },
+	{ KL_COLORBAR_SMPTE_RP_219_1, NULL, 0, 0, -1 },
+	{ KL_COLORBAR_SMPTE_RP_198, "Polarity", 2, 3, -1 },
+	{ KL_COLORBAR_SMPTE_RP_198, NULL, 0, 0, -1 },
+	{ KL_COLORBAR_EIA_189A, "Translucent", 1, 8, 96 },
+	{ KL_COLORBAR_EIA_189A, "Again", 1, 9, -1 },
+	{ KL_COLORBAR_BLACK, NULL, 0, 0, 255 },
+};
+
+static const struct {
+	unsigned int flags;
+	const char *name;
+} seq_variants[] = {
+	{ SEQ_DIRTY, "dirty tracking" },
+	{ SEQ_CACHE, "pattern cache" },
+	{ SEQ_CACHE | SEQ_DIRTY, "pattern cache and dirty tracking" },
+	{ SEQ_EXTERNAL, "external buffers" },
+	{ SEQ_EXTERNAL | SEQ_DIRTY, "external buffers and dirty tracking" },
+	{ SEQ_EXTERNAL | SEQ_CACHE, "external buffers and pattern cache" },
+	{ SEQ_THREADS | SEQ_DIRTY, "threads and dirty tracking" },
+};
+
+static const struct {
+	int width;
+	int height;
+} seq_sizes[] = {
+	{ 1280, 720 },
+	{ 722, 486 },
+};
+
+static int run_sequence(int width, int height, int depth, unsigned int flags,
+			uint64_t *hashes)
+{
+	const unsigned int rowBytes = depth == KL_COLORBAR_10BIT ? ((width + 47) / 48) * 128 :
+		width * 2;
+	/* Padded, so the stride is taken from the caller */
+	const unsigned int stride = rowBytes + 64;
+	const size_t size = (size_t)stride * height;
+	struct kl_colorbar_context ctx;
+	unsigned char *bufs[2];
+	int cur = 0, ret;
+
+	bufs[0] = calloc(2, size);
+	if (bufs[0] == NULL)
+		return -1;
+	bufs[1] = bufs[0] + size;
+
+	if (flags & SEQ_EXTERNAL)
+		ret = kl_colorbar_init_external(&ctx, width, height, depth, bufs[0], stride);
+	else
+		ret = kl_colorbar_init(&ctx, width, height, depth);
+	if (ret < 0) {
+		free(bufs[0]);
+		return -1;
+	}
+
+	ret = -1;
+	if (((flags & SEQ_DIRTY) && kl_colorbar_set_dirty_tracking(&ctx, 1) < 0) ||
+	    ((flags & SEQ_CACHE) && kl_colorbar_set_pattern_cache(&ctx, 1) < 0) ||
+	    ((flags & SEQ_THREADS) && kl_colorbar_set_threads(&ctx, TEST_THREADS) < 0) ||
+	    kl_colorbar_add_counter(&ctx, KL_COLORBAR_COUNTER_FRAMES, 1, 12, 0, 0) < 0 ||
+	    kl_colorbar_add_counter(&ctx, KL_COLORBAR_COUNTER_TIMECODE, 12, 12, 30000, 1001) < 0)
+		goto out;
+	/* Positions that only fit once they wrap round */
+	if (kl_colorbar_add_counter(&ctx, KL_COLORBAR_COUNTER_FRAMES, UINT_MAX - 5, 0, 0, 0) >= 0 ||
+	    kl_colorbar_add_counter(&ctx, KL_COLORBAR_COUNTER_FRAMES, 0, UINT_MAX, 0, 0) >= 0 ||
+	    kl_colorbar_render_string(&ctx, "ab", 2, UINT_MAX, 0) >= 0)
+		goto out;
+	/* Text running off the bottom or right hand edge */
+	if (kl_colorbar_render_string(&ctx, "a", 1, 0, height / ctx.plotheight) >= 0 ||
+	    kl_colorbar_render_string(&ctx, "a", 1, width, 0) >= 0)
+		goto out;
+
+	for (int f = 0; f < SEQ_FRAMES; f++) {
+		unsigned char *frame = bufs[0];
+
+		/* Change buffers part way through, as a card driver handing
+		   out frames would */
+		if ((flags & SEQ_EXTERNAL) && (f == 4 || f == 6)) {
+			cur = !cur;
+			if (kl_colorbar_attach_buffer(&ctx, bufs[cur], stride) < 0)
+				goto out;
+			frame = bufs[cur];
+		} else if (flags & SEQ_EXTERNAL) {
+			frame = bufs[cur];
+		}
+
+		if (seq_frames[f].alpha >= 0 &&
+		    kl_colorbar_set_text_background(&ctx, seq_frames[f].alpha) < 0)
+			goto out;
+		if (kl_colorbar_fill_pattern(&ctx, seq_frames[f].pattern) < 0)
+			goto out;
+		if (seq_frames[f].text) {
+			char str[32];
+
+			snprintf(str, sizeof(str), "%s", seq_frames[f].text);
+			if (kl_colorbar_render_string(&ctx, str, strlen(str), seq_frames[f].x,
+						      seq_frames[f].y) < 0)
+				goto out;
+		}
+
+		/* External contexts are finalized in place */
+		if (kl_colorbar_finalize(&ctx, flags & SEQ_EXTERNAL ? NULL : frame, depth,
+					 stride) < 0)
+			goto out;
+
+		hashes[f] = HASH_INIT;
+		for (int y = 0; y < height; y++)
+			hashes[f] = hash_bytes(hashes[f], frame + (size_t)stride * y, rowBytes);
+	}
+	ret = 0;
+
+out:
+	kl_colorbar_free(&ctx);
+	free(bufs[0]);
+	return ret;
+}
+
+static int check_sequences(const char *pass)
+{
+	int bad = 0, checked = 0;
+
+	for (unsigned int s = 0; s < sizeof(seq_sizes) / sizeof(seq_sizes[0]); s++)
+	for (int depth = KL_COLORBAR_8BIT; depth <= KL_COLORBAR_10BIT; depth++) {
+		const int width = seq_sizes[s].width, height = seq_sizes[s].height;
+		uint64_t plain[SEQ_FRAMES], hashes[SEQ_FRAMES], chain = HASH_INIT;
+		char name[64];
+
+		snprintf(name, sizeof(name), "sequence %dx%d %d-bit", width, height,
+			 depth == KL_COLORBAR_10BIT ? 10 : 8);
+		checked++;
+		if (run_sequence(width, height, depth, 0, plain) < 0) {
+			printf("FAIL %s: %s could not be run\n", pass, name);
+			bad++;
+			continue;
+		}
+		for (int f = 0; f < SEQ_FRAMES; f++)
+			chain = hash_word(chain, plain[f]);
+		bad += check_feature(pass, name, chain);
+		if (generate)
+			continue;
+
+		for (unsigned int v = 0; v < sizeof(seq_variants) / sizeof(seq_variants[0]); v++) {
+			checked++;
+			if (run_sequence(width, height, depth, seq_variants[v].flags, hashes) < 0) {
+				printf("FAIL %s: %s with %s could not be run\n", pass, name,
+				       seq_variants[v].name);
+				bad++;
+				continue;
+			}
+			for (int f = 0; f < SEQ_FRAMES; f++) {
+				if (hashes[f] != plain[f]) {
+					printf("FAIL %s: %s with %s differs at frame %d\n", pass,
+					       name, seq_variants[v].name, f);
+					bad++;
+					break;
+				}
+			}
+		}
+	}
+
+	if (!generate)
+		printf("%-8s sequences: %d checked, %d failed\n", pass, checked, bad);
+	return bad;
+}
+
+/* Samples per frame, and the audio of each frame taken from a tone one
+   after the other, which has to run on without a gap */
+static int check_cadence(void)
+{
+	static const struct {
+		unsigned int rate;
+		unsigned int fps_num;
+		unsigned int fps_den;
+		unsigned int frames;
+		unsigned int cycle_samples;
+		unsigned int count[5]; /* The first few, or 0 */
+	} cases[] = {
+		{ 48000, 30000, 1001, 5, 8008, { 1602, 1601, 1602, 1601, 1602 } },
+		{ 48000, 60000, 1001, 5, 4004, { 801, 801, 800, 801, 801 } },
+		{ 48000, 25, 1, 1, 1920, { 1920 } },
+		{ 44100, 30000, 1001, 100, 147147, { 0 } },
+		{ 192000, 25, 1, 1, 7680, { 7680 } },
+		{ 192000, 30000, 1001, 5, 32032, { 6406, 6407, 6406, 6407, 6406 } },
+		{ 48000, 10, 1, 1, 4800, { 4800 } },
+		/* Longer than the tone's loop, so only extract_frame can have it */
+		{ 48000, 5, 1, 1, 9600, { 9600 } },
+	};
+	int bad = 0, checked = 0;
+
+	for (unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		struct kl_colorbar_audio_cadence cadence;
+		struct kl_colorbar_audio_context audio_ctx;
+		unsigned char *pcm;
+		size_t offset = 0;
+		unsigned int largest = 0;
+		int ok = 1;
+
+		checked++;
+		if (kl_colorbar_audio_cadence_init(&cadence, cases[i].rate, cases[i].fps_num,
+						   cases[i].fps_den) < 0 ||
+		    cadence.frames != cases[i].frames ||
+		    cadence.cycle_samples != cases[i].cycle_samples) {
+			printf("FAIL cadence: %u at %u/%u, wrong cycle\n", cases[i].rate,
+			       cases[i].fps_num, cases[i].fps_den);
+			bad++;
+			continue;
+		}
+		for (unsigned int f = 0; f < cadence.frames; f++) {
+			/* Rounded to nearest */
+			uint64_t first = ((uint64_t)f * cases[i].rate * cases[i].fps_den * 2 +
+					  cases[i].fps_num) / (2ULL * cases[i].fps_num);
+			uint64_t next = f + 1 < cadence.frames ? cadence.first[f + 1] :
+				cadence.cycle_samples;
+
+			if (cadence.first[f] != first || cadence.count[f] != next - first ||
+			    (f < 5 && cases[i].count[f] && cadence.count[f] != cases[i].count[f]))
+				ok = 0;
+			if (cadence.count[f] > largest)
+				largest = cadence.count[f];
+		}
+
+		/* Two cycles of frames, in a stereo tone of a length that doesn't
+		   divide the cycle */
+		if (kl_colorbar_tonegenerator_create(&audio_ctx, 1000, KL_COLORBAR_SAMPLE_S16, 0, 2,
+						     cases[i].rate) < 0) {
+			ok = 0;
+		} else {
+			pcm = malloc(4 * largest);
+			for (unsigned int f = 0; pcm && ok && f < cadence.frames * 2; f++) {
+				struct kl_colorbar_audio_span spans[2];
+				unsigned int count;
+				int n = kl_colorbar_tonegenerator_frame(&audio_ctx, &cadence, f,
+									spans, &count);
+				int samples = kl_colorbar_tonegenerator_extract_frame(&audio_ctx,
+										   &cadence, f, pcm);
+
+				if (samples != (int)cadence.count[f % cadence.frames]) {
+					ok = 0;
+					break;
+				}
+				/* Pointed at in place whenever the loop holds the frame */
+				if (samples <= (int)audio_ctx.samples &&
+				    (n < 1 || count != (unsigned int)samples ||
+				     memcmp(pcm, spans[0].data, spans[0].size) ||
+				     (n == 2 && memcmp(pcm + spans[0].size, spans[1].data,
+						       spans[1].size))))
+					ok = 0;
+				if (samples > (int)audio_ctx.samples && n >= 0)
+					ok = 0;
+				for (int b = 0; b < samples * 4; b++, offset++) {
+					if (pcm[b] != audio_ctx.audio_data[offset %
+									   audio_ctx.audio_data_size])
+						ok = 0;
+				}
+			}
+			if (pcm == NULL)
+				ok = 0;
+			free(pcm);
+			kl_colorbar_tonegenerator_free(&audio_ctx);
+		}
+
+		if (!ok) {
+			printf("FAIL cadence: %u at %u/%u, wrong counts or audio\n", cases[i].rate,
+			       cases[i].fps_num, cases[i].fps_den);
+			bad++;
+		}
+	}
+
+	printf("%-8s cadence: %d checked, %d failed\n", "audio", checked, bad);
+	return bad;
+}
+
+/* Read positions used directly: two cursors on one tone, spans across
+   the end of the loop, a request longer than the loop, and the planes
+   of a planar tone against the same tone interleaved */
+static int peek_is(const struct kl_colorbar_audio_context *audio_ctx,
+		   const struct kl_colorbar_audio_cursor *cursor, size_t bytes, int count,
+		   size_t first, size_t size0, size_t size1)
+{
+	struct kl_colorbar_audio_span spans[2];
+	int n = kl_colorbar_tonegenerator_peek(audio_ctx, cursor, bytes, spans);
+
+	if (n != count || spans[0].data != audio_ctx->audio_data + first ||
+	    spans[0].size != size0)
+		return 0;
+	return n == 1 || (spans[1].data == audio_ctx->audio_data && spans[1].size == size1);
+}
+
+static int check_cursors(void)
+{
+	struct kl_colorbar_audio_context tone, planar, interleaved;
+	struct kl_colorbar_audio_cursor a = { 0 }, b = { 0 };
+	struct kl_colorbar_audio_span spans[2];
+	size_t loop, plane;
+	int checked = 0, bad = 0;
+
+	if (kl_colorbar_tonegenerator_create(&tone, 1000, KL_COLORBAR_SAMPLE_S16, 0, 2,
+					     48000) < 0) {
+		printf("FAIL cursors: no tone\n");
+		return 1;
+	}
+	loop = tone.audio_data_size;
+
+	/* Moving one cursor leaves the other, and the tone's own, alone */
+	checked++;
+	if (!peek_is(&tone, &a, 100, 1, 0, 100, 0) ||
+	    kl_colorbar_tonegenerator_advance(&tone, &a, 100) < 0 ||
+	    !peek_is(&tone, &a, 10, 1, 100, 10, 0) || !peek_is(&tone, &b, 50, 1, 0, 50, 0) ||
+	    kl_colorbar_tonegenerator_advance(&tone, &b, 8) < 0 ||
+	    a.location != 100 || b.location != 8 || !peek_is(&tone, NULL, 4, 1, 0, 4, 0)) {
+		printf("FAIL cursors: not independent\n");
+		bad++;
+	}
+
+	/* Across the end of the loop, and going round it more than once */
+	checked++;
+	if (kl_colorbar_tonegenerator_advance(&tone, &a, loop - 140) < 0 ||
+	    !peek_is(&tone, &a, 100, 2, loop - 40, 40, 60) ||
+	    kl_colorbar_tonegenerator_advance(&tone, &a, 2 * loop + 10) < 0 ||
+	    a.location != loop - 30) {
+		printf("FAIL cursors: wrong at the end of the loop\n");
+		bad++;
+	}
+
+	/* At most one loop at a time */
+	checked++;
+	if (!peek_is(&tone, &b, 3 * loop, 2, 8, loop - 8, 8) ||
+	    !peek_is(&tone, NULL, loop + 1, 1, 0, loop, 0)) {
+		printf("FAIL cursors: a request longer than the loop wasn't cut to it\n");
+		bad++;
+	}
+
+	checked++;
+	b.location = loop;
+	if (kl_colorbar_tonegenerator_peek(&tone, &b, 4, spans) >= 0) {
+		printf("FAIL cursors: a position past the loop was taken\n");
+		bad++;
+	}
+	kl_colorbar_tonegenerator_free(&tone);
+
+	/* Every channel of a planar tone is a plane further on, and holds
+	   what the same channel does interleaved */
+	checked++;
+	if (kl_colorbar_tonegenerator_create(&planar, 997, KL_COLORBAR_SAMPLE_S24_32,
+					     KL_COLORBAR_AUDIO_PLANAR, 4, 48000) < 0 ||
+	    kl_colorbar_tonegenerator_create(&interleaved, 997, KL_COLORBAR_SAMPLE_S24_32, 0, 4,
+					     48000) < 0) {
+		printf("FAIL cursors: no planar tone\n");
+		return bad + 1;
+	}
+	plane = planar.samples * 4;
+	a.location = plane - 8;
+	if (!peek_is(&planar, &a, 16, 2, plane - 8, 8, 8) ||
+	    !peek_is(&planar, &a, plane + 4, 2, plane - 8, 8, plane - 8)) {
+		printf("FAIL cursors: planar spans outside the first plane\n");
+		bad++;
+	} else {
+		int wrong = 0;
+
+		kl_colorbar_tonegenerator_peek(&planar, &a, 16, spans);
+		for (int i = 0; i < 2; i++) {
+			size_t first = (spans[i].data - planar.audio_data) / 4;
+
+			for (unsigned int c = 0; c < 4; c++) {
+				for (size_t n = 0; n < spans[i].size / 4; n++) {
+					if (memcmp(spans[i].data + c * plane + n * 4,
+						   interleaved.audio_data + ((first + n) * 4 + c) * 4,
+						   4) != 0)
+						wrong = 1;
+				}
+			}
+		}
+		if (wrong) {
+			printf("FAIL cursors: planar channels at the wrong offsets\n");
+			bad++;
+		}
+	}
+	kl_colorbar_tonegenerator_free(&planar);
+	kl_colorbar_tonegenerator_free(&interleaved);
+
+	printf("%-8s cursors: %d checked, %d failed\n", "audio", checked, bad);
+	return bad;
+}
+
+/* A/V sync signal looped straight back into the analyzer, which has
+   to find every flash and beep exactly together */
+static const struct avsync_case {
+	int depth;
+	enum kl_colorbar_sample_format format;
+	unsigned int flags;
+} avsync_cases[] = {
+	{ KL_COLORBAR_10BIT, KL_COLORBAR_SAMPLE_S16, 0 },
+	{ KL_COLORBAR_8BIT, KL_COLORBAR_SAMPLE_S16, 0 },
+	{ KL_COLORBAR_10BIT, KL_COLORBAR_SAMPLE_S16, KL_COLORBAR_AUDIO_BIG_ENDIAN },
+	{ KL_COLORBAR_10BIT, KL_COLORBAR_SAMPLE_S24_32, KL_COLORBAR_AUDIO_BIG_ENDIAN },
+	{ KL_COLORBAR_10BIT, KL_COLORBAR_SAMPLE_FLOAT32, KL_COLORBAR_AUDIO_BIG_ENDIAN },
+};
+
+static int avsync_loopback(const char *pass, const struct avsync_case *c)
+{
+	const int width = 1280, height = 720, period = 30, frames = 120;
+	const unsigned int stride = c->depth == KL_COLORBAR_10BIT ? ((width + 47) / 48) * 128 :
+		width * 2;
+	struct kl_colorbar_context ctx;
+	struct kl_colorbar_audio_context audio_ctx;
+	struct kl_colorbar_audio_cadence cadence;
+	struct kl_colorbar_avsync_analyzer an;
+	unsigned char *frame = malloc(stride * height);
+	unsigned char *pcm = malloc(1602 * 2 * 4);
+	int bad = 0;
+
+	if (frame == NULL || pcm == NULL ||
+	    kl_colorbar_init(&ctx, width, height, c->depth) < 0) {
+		printf("FAIL %s: A/V sync signal could not be set up\n", pass);
+		free(frame);
+		free(pcm);
+		return 1;
+	}
+	kl_colorbar_audio_cadence_init(&cadence, 48000, 30000, 1001);
+	if (kl_colorbar_tonegenerator_avsync(&audio_ctx, &cadence, period, 1000,
+					     c->format, c->flags, 2, 48000) < 0 ||
+	    kl_colorbar_avsync_analyzer_init(&an, width, height, stride, c->depth,
+					     48000, 30000, 1001, c->format, c->flags,
+					     2, 0) < 0) {
+		printf("FAIL %s: A/V sync signal could not be set up\n", pass);
+		kl_colorbar_free(&ctx);
+		free(frame);
+		free(pcm);
+		return 1;
+	}
+
+	for (int f = 0; f < frames; f++) {
+		int samples = kl_colorbar_tonegenerator_extract_frame(&audio_ctx, &cadence, f, pcm);
+
+		kl_colorbar_fill_avsync(&ctx, period, f);
+		kl_colorbar_finalize(&ctx, frame, c->depth, stride);
+		kl_colorbar_avsync_analyze_frame(&an, frame);
+		if (samples > 0)
+			kl_colorbar_avsync_analyze_audio(&an, pcm, samples);
+	}
+
+	if (an.stats.measurements < (unsigned long long)frames / period - 1 ||
+	    an.stats.min_offset != 0 || an.stats.max_offset != 0) {
+		printf("FAIL %s: A/V sync loopback, %d-bit, format %d, flags %u, "
+		       "%llu measurements, offset %lld..%lld\n",
+		       pass, c->depth == KL_COLORBAR_10BIT ? 10 : 8, c->format, c->flags,
+		       an.stats.measurements, an.stats.min_offset, an.stats.max_offset);
+		bad++;
+	}
+
+	kl_colorbar_tonegenerator_free(&audio_ctx);
+	kl_colorbar_free(&ctx);
+	free(frame);
+	free(pcm);
+	return bad;
+}
+
+static int check_avsync(const char *pass)
+{
+	const int count = sizeof(avsync_cases) / sizeof(avsync_cases[0]);
+	int bad = 0;
+
+	for (int i = 0; i < count; i++)
+		bad += avsync_loopback(pass, &avsync_cases[i]);
+	printf("%-8s avsync: %d loopbacks, %d failed\n", pass, count, bad);
+	return bad;
+}
+
+/* The verifier against frames straight from the library, which have to
+   pass with no tolerance at all.  Then the widest bar is nudged up a
+   little, which has to fail that bar and no other. */
+static int verify_case(const char *pass, int pattern, int width, int height, int depth)
+{
+	const unsigned int stride = depth == KL_COLORBAR_10BIT ? ((width + 47) / 48) * 128 :
+		width * 2;
+	struct kl_colorbar_context ctx;
+	struct kl_colorbar_verifier v;
+	const struct kl_colorbar_verify_region *r;
+	unsigned char *frame;
+	unsigned int widest = 0;
+	int clean, corrupt, bad = 0;
+
+	frame = calloc(height, stride);
+	if (frame == NULL)
+		return 1;
+
+	if (kl_colorbar_init(&ctx, width, height, depth) < 0) {
+		free(frame);
+		return 1;
+	}
+	if (kl_colorbar_fill_pattern(&ctx, pattern) < 0 ||
+	    kl_colorbar_finalize(&ctx, frame, depth, stride) < 0 ||
+	    kl_colorbar_verifier_init(&v, width, height, stride, depth, pattern, 0) < 0) {
+		kl_colorbar_free(&ctx);
+		free(frame);
+		return 1;
+	}
+	kl_colorbar_free(&ctx);
+
+	clean = kl_colorbar_verify_frame(&v, frame);
+
+	for (unsigned int i = 1; i < v.regions; i++) {
+		if (v.region[i].width > v.region[widest].width)
+			widest = i;
+	}
+	r = &v.region[widest];
+	for (unsigned int y = r->y; y < r->y + r->height; y++) {
+		unsigned char *line = frame + (size_t)stride * y;
+
+		if (depth == KL_COLORBAR_10BIT) {
+			/* Every component of the groups wholly inside the bar */
+			for (unsigned int g = (r->x + 5) / 6; g < (r->x + r->width) / 6; g++) {
+				for (int w = 0; w < 4; w++) {
+					unsigned char *p = line + g * 16 + w * 4;
+					uint32_t word = p[0] | p[1] << 8 | p[2] << 16 |
+						(uint32_t)p[3] << 24;
+
+					word += (8 << 20) | (8 << 10) | 8;
+					for (int b = 0; b < 4; b++)
+						p[b] = word >> (b * 8);
+				}
+			}
+		} else {
+			for (unsigned int x = r->x; x < r->x + r->width; x++)
+				line[x * 2 + 1] += 3;
+		}
+	}
+
+	corrupt = kl_colorbar_verify_frame(&v, frame);
+	if (clean != 1 || v.regions == 0) {
+		printf("%-8s verifier: pattern %d %dx%d %d-bit, %u of %u bars failed a clean frame\n",
+		       pass, pattern, width, height, depth == KL_COLORBAR_10BIT ? 10 : 8,
+		       v.failed, v.regions);
+		bad++;
+	} else if (corrupt != 0 || v.failed != 1 || !v.region[widest].failed) {
+		printf("%-8s verifier: pattern %d %dx%d %d-bit, corrupted bar %u not caught alone\n",
+		       pass, pattern, width, height, depth == KL_COLORBAR_10BIT ? 10 : 8, widest);
+		bad++;
+	}
+
+	kl_colorbar_verifier_free(&v);
+	free(frame);
+	return bad;
+}
+
+static int check_verify(const char *pass)
+{
+	const int patterns = sizeof(pattern_symbols) / sizeof(pattern_symbols[0]);
+	const int sizes = sizeof(resolutions) / sizeof(resolutions[0]);
+	int checked = 0, bad = 0;
+
+	for (int p = 0; p < patterns; p++) {
+		for (int r = 0; r < sizes; r++) {
+			for (int depth = KL_COLORBAR_8BIT; depth <= KL_COLORBAR_10BIT; depth++) {
+				bad += verify_case(pass, p, resolutions[r].width,
+						   resolutions[r].height, depth);
+				checked++;
+			}
+		}
+	}
+	printf("%-8s verifier: %d checked, %d failed\n", pass, checked, bad);
+	return bad;
+}
+
+/* Pacing against a mock clock, which wakes every sleep a little late
+   by an amount that depends on the frame, and jumps ahead once in a
+   while as if a delivery had stalled */
+#define PACE_FRAMES 30000
+#define PACE_START 1000000000ULL
+#define PACE_STALL_EVERY 7001
+#define PACE_STALL_NS 100000000ULL
+
+struct mock_clock {
+	unsigned long long now;
+	unsigned long long delivered;
+	unsigned long long jitter[KL_COLORBAR_JITTER_BINS];
+	unsigned long long late;
+	int bad;
+};
+
+static unsigned long long mock_now(void *priv)
+{
+	struct mock_clock *m = priv;
+
+	return m->now;
+}
+
+static void mock_sleep_until(unsigned long long time, void *priv)
+{
+	struct mock_clock *m = priv;
+
+	if (time > m->now)
+		m->now = time + (m->delivered % 4) * 1500;
+}
+
+/* Due time of frame n at 30000/1001 */
+static unsigned long long pace_due(unsigned long long n)
+{
+	return PACE_START + (n + 1) * 1001 * 1000000000ULL / 30000;
+}
+
+static int mock_deliver(const struct kl_colorbar_frame *frame, unsigned long long time, void *priv)
+{
+	struct mock_clock *m = priv;
+	unsigned long long n = m->delivered++;
+	unsigned long long jitter = m->now - time;
+	unsigned long long us = jitter / 1000;
+	int bin = 0;
+
+	if (time != pace_due(n) || m->now < time)
+		m->bad++;
+
+	while (us && bin < KL_COLORBAR_JITTER_BINS - 1) {
+		us >>= 1;
+		bin++;
+	}
+	m->jitter[bin]++;
+	if (jitter >= pace_due(n + 1) - pace_due(n))
+		m->late++;
+
+	if (n % PACE_STALL_EVERY == PACE_STALL_EVERY - 1)
+		m->now += PACE_STALL_NS;
+	return 0;
+}
+
+static int check_pacing(void)
+{
+	struct mock_clock m = { PACE_START };
+	const struct kl_colorbar_clock clock = { mock_now, mock_sleep_until, &m };
+	struct kl_colorbar_pacing pacing;
+	struct kl_colorbar_pacing_stats stats;
+	struct kl_colorbar_context ctx;
+	int bad = 0;
+
+	memset(&pacing, 0, sizeof(pacing));
+	pacing.fps_num = 30000;
+	pacing.fps_den = 1001;
+	pacing.format = KL_COLORBAR_FORMAT_UYVY;
+	pacing.pattern = KL_COLORBAR_SMPTE_RP_219_1;
+	pacing.deliver = mock_deliver;
+	pacing.priv = &m;
+	pacing.clock = &clock;
+	pacing.frames = PACE_FRAMES;
+
+	if (kl_colorbar_init(&ctx, 64, 32, KL_COLORBAR_8BIT) < 0 ||
+	    kl_colorbar_pace(&ctx, &pacing, &stats) < 0) {
+		printf("FAIL pacing: could not be run\n");
+		return 1;
+	}
+
+	/* 30000 frames at 30000/1001 take exactly 1001s, every one of them
+	   due on time whatever went before */
+	if (m.bad || m.delivered != PACE_FRAMES || stats.frames != PACE_FRAMES ||
+	    pace_due(PACE_FRAMES - 1) - PACE_START != 1001000000000ULL) {
+		printf("FAIL pacing: %llu frames delivered, %d off schedule\n", m.delivered, m.bad);
+		bad++;
+	}
+	if (stats.late != m.late || stats.late != PACE_FRAMES / PACE_STALL_EVERY ||
+	    stats.dropped != 0 ||
+	    memcmp(stats.jitter, m.jitter, sizeof(m.jitter)) != 0) {
+		printf("FAIL pacing: %llu late, %llu dropped, or jitter histogram differs\n",
+		       stats.late, stats.dropped);
+		bad++;
+	}
+	printf("%-8s pacing: %llu frames, %llu late, %d failed\n", "mock", stats.frames,
+	       stats.late, bad);
+
+	kl_colorbar_free(&ctx);
+	return bad;
+}
+
+/* The frame pool, against a context rendering the same frames itself.
+   Its render callback can be held up after a number of frames, which
+   leaves the pool with nothing more to hand out. */
+#define POOL_FRAMES 3
+#define POOL_TAKE 12
+#define POOL_WAIT_NS 1000000
+
+struct pool_gate {
+	unsigned int rendered; /* Only touched by the pool's thread */
+	unsigned int allowed; /* Frames rendered before holding up, or 0 */
+	atomic_int release;
+};
+
+static void pool_render(struct kl_colorbar_context *ctx, void *priv)
+{
+	struct pool_gate *gate = priv;
+	const struct timespec pause = { 0, POOL_WAIT_NS };
+
+	if (gate->allowed && ++gate->rendered > gate->allowed) {
+		while (!atomic_load(&gate->release))
+			nanosleep(&pause, NULL);
+	}
+}
+
+static int pool_deliver(const struct kl_colorbar_frame *frame, unsigned long long time,
+			void *priv)
+{
+	struct mock_clock *m = priv;
+
+	if (frame->pic_count != m->delivered++)
+		m->bad++;
+	return 0;
+}
+
+/* Start a pool and wait for all its frames to be rendered */
+static int pool_fill(struct kl_colorbar_context *ctx, struct pool_gate *gate)
+{
+	const struct timespec pause = { 0, POOL_WAIT_NS };
+	struct kl_colorbar_frame_pool_stats stats;
+
+	if (kl_colorbar_frame_pool_start(ctx, POOL_FRAMES, KL_COLORBAR_FORMAT_NV12,
+					 KL_COLORBAR_EIA_189A, pool_render, gate) < 0)
+		return -1;
+	for (int i = 0; i < 10000; i++) {
+		if (kl_colorbar_frame_pool_get_stats(ctx, &stats) < 0)
+			return -1;
+		if (stats.depth == POOL_FRAMES)
+			return 0;
+		nanosleep(&pause, NULL);
+	}
+	return -1;
+}
+
+static const struct {
+	unsigned int fps_num;
+	unsigned int fps_den;
+	unsigned long long frames; /* To pace, or 0 to go on until it gives up */
+	int ret;
+	unsigned long long dropped;
+} pool_runs[] = {
+	{ 30000, 1001, 10, 0, 10 - POOL_FRAMES },
+	{ 30000, 1001, 0, -1, 31 },
+	{ 1, 2, 0, -1, 2 },
+};
+
+static int check_frame_pool(void)
+{
+	const struct timespec pause = { 0, POOL_WAIT_NS };
+	struct kl_colorbar_context ctx, ref;
+	struct kl_colorbar_frame_pool_stats stats;
+	struct kl_colorbar_frame expect;
+	struct pool_gate gate = { 0, 0 };
+	unsigned long long nulls = 0;
+	unsigned char *data = NULL;
+	size_t bytes;
+	int got = 0, bad = 0;
+
+	if (kl_colorbar_init(&ctx, 320, 240, KL_COLORBAR_8BIT) < 0)
+		return 1;
+	if (kl_colorbar_init(&ref, 320, 240, KL_COLORBAR_8BIT) < 0) {
+		kl_colorbar_free(&ctx);
+		return 1;
+	}
+	bytes = kl_frame_layout(&ref, KL_COLORBAR_FORMAT_NV12, NULL, NULL);
+	if (bytes)
+		data = calloc(1, bytes);
+	if (data == NULL ||
+	    kl_colorbar_add_counter(&ctx, KL_COLORBAR_COUNTER_FRAMES, 1, 4, 0, 0) < 0 ||
+	    kl_colorbar_add_counter(&ref, KL_COLORBAR_COUNTER_FRAMES, 1, 4, 0, 0) < 0 ||
+	    kl_colorbar_frame_pool_start(&ctx, 0, KL_COLORBAR_FORMAT_NV12,
+					 KL_COLORBAR_EIA_189A, NULL, NULL) == 0 ||
+	    kl_colorbar_frame_pool_start(&ctx, POOL_FRAMES, KL_COLORBAR_FORMAT_NV12,
+					 (enum kl_colorbar_pattern)1000, NULL, NULL) == 0 ||
+	    kl_colorbar_frame_pool_start(&ctx, POOL_FRAMES, KL_COLORBAR_FORMAT_NV12,
+					 KL_COLORBAR_EIA_189A, pool_render, &gate) < 0) {
+		printf("FAIL frame pool: could not be started, or took bad arguments\n");
+		bad++;
+		goto out;
+	}
+	kl_frame_layout(&ref, KL_COLORBAR_FORMAT_NV12, &expect, data);
+
+	/* Frames come out in order, each as the context would have
+	   rendered it, and go round the pool several times */
+	while (got < POOL_TAKE && nulls < 10000) {
+		struct kl_colorbar_frame *frame = kl_colorbar_frame_pool_get(&ctx);
+
+		if (frame == NULL) {
+			nulls++;
+			nanosleep(&pause, NULL);
+			continue;
+		}
+		expect.pic_count = ref.pic_count;
+		if (kl_colorbar_fill_pattern(&ref, KL_COLORBAR_EIA_189A) < 0 ||
+		    kl_colorbar_finalize_planes(&ref, &expect.planes) < 0 ||
+		    frame->pic_count != expect.pic_count ||
+		    memcmp(frame->planes.data[0], data, bytes) != 0) {
+			printf("FAIL frame pool: frame %d differs\n", got);
+			bad++;
+		}
+		if (kl_colorbar_frame_pool_put(&ctx, frame) < 0)
+			bad++;
+		got++;
+	}
+	if (kl_colorbar_frame_pool_get_stats(&ctx, &stats) < 0 || got != POOL_TAKE ||
+	    stats.frames != POOL_FRAMES || stats.delivered != POOL_TAKE ||
+	    stats.underruns != nulls || stats.errors != 0 || stats.rendered < POOL_TAKE ||
+	    stats.depth > POOL_FRAMES) {
+		printf("FAIL frame pool: %d taken, counters wrong\n", got);
+		bad++;
+	}
+	kl_colorbar_frame_pool_stop(&ctx);
+
+	/* Paced from a pool that stops rendering after the frames it
+	   starts with: the rest are dropped, and with no end set, pacing
+	   gives up after a second of them, or one below 1fps */
+	for (unsigned int run = 0; run < sizeof(pool_runs) / sizeof(pool_runs[0]); run++) {
+		struct mock_clock m = { PACE_START };
+		const struct kl_colorbar_clock clock = { mock_now, mock_sleep_until, &m };
+		struct kl_colorbar_pacing pacing;
+		struct kl_colorbar_pacing_stats pace;
+		int ret;
+
+		memset(&pacing, 0, sizeof(pacing));
+		pacing.fps_num = pool_runs[run].fps_num;
+		pacing.fps_den = pool_runs[run].fps_den;
+		pacing.deliver = pool_deliver;
+		pacing.priv = &m;
+		pacing.clock = &clock;
+		pacing.frames = pool_runs[run].frames;
+
+		gate.rendered = 0;
+		gate.allowed = POOL_FRAMES;
+		atomic_store(&gate.release, 0);
+		ctx.pic_count = 0;
+		if (pool_fill(&ctx, &gate) < 0) {
+			printf("FAIL frame pool: could not be filled for pacing\n");
+			bad++;
+			atomic_store(&gate.release, 1);
+			kl_colorbar_frame_pool_stop(&ctx);
+			break;
+		}
+
+		ret = kl_colorbar_pace(&ctx, &pacing, &pace);
+		if (ret != pool_runs[run].ret || m.bad || m.delivered != POOL_FRAMES ||
+		    pace.frames != POOL_FRAMES || pace.dropped != pool_runs[run].dropped ||
+		    kl_colorbar_frame_pool_get_stats(&ctx, &stats) < 0 ||
+		    stats.underruns != pool_runs[run].dropped) {
+			printf("FAIL frame pool: paced %llu frames, %llu dropped, returned %d\n",
+			       pace.frames, pace.dropped, ret);
+			bad++;
+		}
+
+		atomic_store(&gate.release, 1);
+		kl_colorbar_frame_pool_stop(&ctx);
+	}
+
+out:
+	printf("%-8s frame pool: %d frames taken, %llu underruns, %d failed\n", "threads",
+	       got, nulls, bad);
+	free(data);
+	kl_colorbar_free(&ref);
+	kl_colorbar_free(&ctx);
+	return bad;
+}
+
+/* The EIA-189A frame the tool has always written out, for a look at it
+   in a YUV viewer */
+static int write_sample(const char *filename)
 {
 	struct kl_colorbar_context osd_ctx;
-	int width=640, height=480;
+	int width = 640, height = 480;
 	unsigned char *buf;
 	int ret;
 
@@ -16,28 +1579,16 @@ int main()
 	int rowWidth = ((width + 47) / 48) * 128;
 	fprintf(stderr, "row stride is %d\n", rowWidth);
 
-	buf = malloc(rowWidth * height);
-	memset(buf, 0, rowWidth * height);
+	buf = calloc(rowWidth, height);
 	kl_colorbar_init(&osd_ctx, width, height, KL_COLORBAR_10BIT);
-
-	/* List all available patterns */
-	for (int i = 0; i < 255; i++) {
-		const char *name = kl_colorbar_get_pattern_name(&osd_ctx, i);
-		if (name == NULL)
-			break;
-		printf("Pattern %d: %s\n", i, name);
-	}
-
 	kl_colorbar_fill_pattern(&osd_ctx, KL_COLORBAR_EIA_189A);
 	kl_colorbar_finalize(&osd_ctx, buf, KL_COLORBAR_10BIT, rowWidth);
-	for (int i = 0; i < 32; i++) {
-		printf("%02x ", buf[i]);
-	}
-	printf("\n");
 
-	int fd = open("foo.yuv", O_WRONLY | O_TRUNC | O_CREAT, 0644);
+	int fd = open(filename, O_WRONLY | O_TRUNC | O_CREAT, 0644);
 	if (fd < 0) {
 		fprintf(stderr, "Failed to open output file\n");
+		kl_colorbar_free(&osd_ctx);
+		free(buf);
 		return 1;
 	}
 	ret = write(fd, buf, rowWidth * height);
@@ -49,5 +1600,77 @@ int main()
 
 	kl_colorbar_free(&osd_ctx);
 	free(buf);
-	return 0;
+	return ret < 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct kl_colorbar_context osd_ctx;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "go:h")) != -1) {
+		switch (ch) {
+		case 'g':
+			generate = 1;
+			break;
+		case 'o':
+			return write_sample(optarg);
+		default:
+			fprintf(stderr, "Usage: %s [-g] [-o file.yuv]\n"
+				"  -g  Print a new golden table from the scalar kernels\n"
+				"  -o  Write a 640x480 V210 EIA-189A frame to a file\n", argv[0]);
+			return ch == 'h' ? 0 : 1;
+		}
+	}
+
+	if (generate) {
+		kl_colorbar_set_cpu_level(KL_COLORBAR_CPU_SCALAR);
+		printf("/* Generated by klbars_test -g, from the scalar kernels */\n\n");
+		printf("static const struct golden_frame golden_frames[] = {\n");
+		check_frames("scalar", 1);
+		printf("};\n\nstatic const struct golden_tone golden_tones[] = {\n");
+		check_tones("scalar");
+		printf("};\n\nstatic const struct golden_feature golden_features[] = {\n");
+		check_multi_tones("scalar");
+		check_sequences("scalar");
+		printf("};\n");
+		return 0;
+	}
+
+	/* List all available patterns */
+	kl_colorbar_init(&osd_ctx, 640, 480, KL_COLORBAR_10BIT);
+	for (int i = 0; i < 255; i++) {
+		const char *name = kl_colorbar_get_pattern_name(&osd_ctx, i);
+		if (name == NULL)
+			break;
+		printf("Pattern %d: %s\n", i, name);
+	}
+	kl_colorbar_free(&osd_ctx);
+
+	for (int level = KL_COLORBAR_CPU_SCALAR; level <= KL_COLORBAR_CPU_AVX2; level++) {
+		if (kl_colorbar_set_cpu_level(level) < 0) {
+			printf("%-8s skipped, not supported by this CPU\n", level_names[level]);
+			continue;
+		}
+		failures += check_frames(level_names[level], 1);
+		failures += check_tones(level_names[level]);
+		failures += check_multi_tones(level_names[level]);
+		failures += check_kernels(level_names[level]);
+		failures += check_odd_width(level_names[level]);
+		failures += check_sequences(level_names[level]);
+		failures += check_avsync(level_names[level]);
+		failures += check_verify(level_names[level]);
+	}
+
+	failures += check_pattern_file();
+
+	/* The best level the CPU has is still selected */
+	failures += check_frames("threads", TEST_THREADS);
+	failures += check_cadence();
+	failures += check_cursors();
+	failures += check_pacing();
+	failures += check_frame_pool();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
 }